@@ -20,6 +20,7 @@ set(GTBOT_CONFIGURE_MODULE Platform CACHE STRING "Module to configure")
 set_property(CACHE GTBOT_CONFIGURE_MODULE PROPERTY STRINGS "Platform;Tests")
 
 set(GTBOT_CPP_STANDARD 20 CACHE STRING "C++ standard")
+set(GTBOT_BUILD_TOOLS ON CACHE BOOL "Build the tools (make_dataset, pack_assets)")
 set(GTBOT_SOURCES_DIR ${root}/sources CACHE PATH "Sources directory")
 set(GTBOT_PLATFORM_SOURCES_DIR ${GTBOT_SOURCES_DIR}/platform/${PLATFORM} CACHE PATH "Platform sources")
 set(GTBOT_LIBRARIES_DIR ${root}/libraries CACHE PATH "Libraries directory")
@@ -43,6 +44,7 @@ message(STATUS "Configure module:                | ${GTBOT_CONFIGURE_MODULE}")
 message(STATUS "Platform:                        | ${PLATFORM} (${ARCHITECTURE})")
 message(STATUS "Build types:                     | ${CMAKE_CONFIGURATION_TYPES}")
 message(STATUS "C++ standard:                    | ${GTBOT_CPP_STANDARD}")
+message(STATUS "Build tools:                     | ${GTBOT_BUILD_TOOLS}")
 message(STATUS "Directories:                     |")
 message(STATUS "    Sources:                     | ${GTBOT_SOURCES_DIR}")
 message(STATUS "    Platform:                    | ${GTBOT_PLATFORM_SOURCES_DIR}")
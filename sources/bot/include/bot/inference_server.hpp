@@ -0,0 +1,93 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include <condition_variable>
+#include <core/aliases.hpp>
+#include <neural/shared_weights.hpp>
+
+namespace golxzn::bot {
+
+/**
+ * @brief Collects the concurrent inference requests into batches
+ * @details The worker takes the batch when `max_batch_size` requests are queued or when the
+ * oldest request has waited for `max_wait`, whichever comes first, and runs it as the single
+ * batched forward pass. The bigger `max_wait` gives the bigger batches (throughput), the smaller
+ * one gives the faster responses (latency).
+ */
+class InferenceServer {
+public:
+	using clock = std::chrono::steady_clock;
+	using result_t = std::vector<core::f32>;
+
+	static constexpr std::string_view class_name{ "bot::InferenceServer" };
+
+	struct Settings {
+		core::u32 max_batch_size{ 32 };
+		std::chrono::microseconds max_wait{ 2000 };
+		core::u32 workers_count{ 1 };
+		core::u32 max_queue_depth{ 4096 }; ///< the requests above it are rejected. 0 means unlimited
+	};
+
+	struct Metrics {
+		core::u64 requests{};
+		core::u64 rejected{};
+		core::u64 batches{};
+		core::u64 full_batches{}; ///< batches taken because of `max_batch_size` rather than `max_wait`
+		core::u32 queue_depth{};
+		core::u32 peak_queue_depth{};
+		core::f64 average_batch_size{};
+		std::chrono::microseconds average_wait{};
+	};
+
+	explicit InferenceServer(core::sptr<const neural::SharedWeights> weights);
+	InferenceServer(core::sptr<const neural::SharedWeights> weights, const Settings &settings);
+	~InferenceServer();
+
+	InferenceServer(const InferenceServer &) = delete;
+	InferenceServer &operator=(const InferenceServer &) = delete;
+
+	/**
+	 * @brief Queue the input for the inference
+	 * @return the future of the output. It's empty if the request was rejected or invalid
+	 */
+	nodis std::future<result_t> submit(std::vector<core::f32> input);
+
+	/** @brief Finish the queued requests and stop the workers */
+	void stop();
+
+	nodis bool running() const noexcept;
+	nodis const Settings &settings() const noexcept;
+	nodis Metrics metrics() const;
+
+private:
+	struct Request {
+		std::vector<core::f32> input;
+		std::promise<result_t> promise;
+		clock::time_point queued;
+	};
+
+	core::sptr<const neural::SharedWeights> mWeights;
+	Settings mSettings;
+
+	mutable std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::deque<Request> mQueue;
+	std::vector<std::thread> mWorkers;
+	bool mRunning{ false };
+
+	Metrics mMetrics{};
+	core::u64 mBatchedRequests{};
+	std::chrono::microseconds mTotalWait{};
+
+	void work();
+	std::vector<Request> take_batch(std::unique_lock<std::mutex> &lock);
+
+	static std::future<result_t> make_ready(result_t &&result = {});
+};
+
+} // namespace golxzn::bot
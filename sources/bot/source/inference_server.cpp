@@ -0,0 +1,153 @@
+#include <core/common>
+#include <neural/inference_context.hpp>
+
+#include "bot/inference_server.hpp"
+
+namespace golxzn::bot {
+
+InferenceServer::InferenceServer(core::sptr<const neural::SharedWeights> weights)
+	: InferenceServer{ std::move(weights), Settings{} } {}
+
+InferenceServer::InferenceServer(core::sptr<const neural::SharedWeights> weights, const Settings &settings)
+	: mWeights{ std::move(weights) }, mSettings{ settings } {
+	if (mWeights == nullptr || !mWeights->valid()) [[unlikely]] {
+		spdlog::error("[{}]: Cannot start without valid weights", class_name);
+		return;
+	}
+	mSettings.max_batch_size = (std::max)(mSettings.max_batch_size, core::u32{ 1 });
+	mSettings.workers_count = (std::max)(mSettings.workers_count, core::u32{ 1 });
+
+	mRunning = true;
+	mWorkers.reserve(mSettings.workers_count);
+	for (core::u32 i{}; i < mSettings.workers_count; ++i) {
+		mWorkers.emplace_back(&InferenceServer::work, this);
+	}
+}
+
+InferenceServer::~InferenceServer() {
+	stop();
+}
+
+std::future<InferenceServer::result_t> InferenceServer::submit(std::vector<core::f32> input) {
+	if (mWeights == nullptr || input.size() != mWeights->input_count()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid request input size {}", class_name, input.size());
+		return make_ready();
+	}
+
+	std::future<result_t> future;
+	{
+		std::lock_guard lock{ mMutex };
+		if (!mRunning || (mSettings.max_queue_depth != 0 && mQueue.size() >= mSettings.max_queue_depth)) [[unlikely]] {
+			++mMetrics.rejected;
+			return make_ready();
+		}
+
+		auto &request{ mQueue.emplace_back(Request{ std::move(input), {}, clock::now() }) };
+		future = request.promise.get_future();
+		++mMetrics.requests;
+		mMetrics.peak_queue_depth = (std::max)(mMetrics.peak_queue_depth, static_cast<core::u32>(mQueue.size()));
+	}
+	mCondition.notify_one();
+	return future;
+}
+
+void InferenceServer::stop() {
+	{
+		std::lock_guard lock{ mMutex };
+		if (!mRunning) return;
+		mRunning = false;
+	}
+	mCondition.notify_all();
+	for (auto &worker : mWorkers) {
+		if (worker.joinable()) worker.join();
+	}
+	mWorkers.clear();
+}
+
+bool InferenceServer::running() const noexcept {
+	std::lock_guard lock{ mMutex };
+	return mRunning;
+}
+
+const InferenceServer::Settings &InferenceServer::settings() const noexcept { return mSettings; }
+
+InferenceServer::Metrics InferenceServer::metrics() const {
+	std::lock_guard lock{ mMutex };
+	auto metrics{ mMetrics };
+	metrics.queue_depth = static_cast<core::u32>(mQueue.size());
+	if (metrics.batches != 0) {
+		metrics.average_batch_size = static_cast<core::f64>(mBatchedRequests) / metrics.batches;
+	}
+	if (mBatchedRequests != 0) {
+		metrics.average_wait = mTotalWait / mBatchedRequests;
+	}
+	return metrics;
+}
+
+void InferenceServer::work() {
+	neural::InferenceContext context{ mWeights };
+	const auto input_count{ mWeights->input_count() };
+	const auto output_count{ mWeights->output_count() };
+	std::vector<core::f32> inputs;
+
+	for (;;) {
+		std::vector<Request> batch;
+		{
+			std::unique_lock lock{ mMutex };
+			batch = take_batch(lock);
+		}
+		if (batch.empty()) return;
+
+		const auto batch_size{ static_cast<core::u32>(batch.size()) };
+		inputs.resize(static_cast<size_t>(batch_size) * input_count);
+		for (size_t i{}; i < batch.size(); ++i) {
+			std::ranges::copy(batch[i].input, std::begin(inputs) + i * input_count);
+		}
+
+		const auto outputs{ context.predict_batch(inputs, batch_size) };
+		for (size_t i{}; i < batch.size(); ++i) {
+			if (outputs.empty()) [[unlikely]] {
+				batch[i].promise.set_value({});
+				continue;
+			}
+			const auto output{ outputs.subspan(i * output_count, output_count) };
+			batch[i].promise.set_value(result_t{ std::begin(output), std::end(output) });
+		}
+	}
+}
+
+std::vector<InferenceServer::Request> InferenceServer::take_batch(std::unique_lock<std::mutex> &lock) {
+	do {
+		mCondition.wait(lock, [this] { return !mQueue.empty() || !mRunning; });
+		if (mQueue.empty()) return {}; // stopped
+
+		const auto deadline{ mQueue.front().queued + mSettings.max_wait };
+		mCondition.wait_until(lock, deadline, [this] {
+			return mQueue.size() >= mSettings.max_batch_size || !mRunning;
+		});
+	} while (mQueue.empty()); // taken by the other worker meanwhile
+
+	const auto count{ std::min<size_t>(mQueue.size(), mSettings.max_batch_size) };
+	const auto now{ clock::now() };
+	std::vector<Request> batch;
+	batch.reserve(count);
+	for (size_t i{}; i < count; ++i) {
+		auto &request{ mQueue.front() };
+		mTotalWait += std::chrono::duration_cast<std::chrono::microseconds>(now - request.queued);
+		batch.emplace_back(std::move(request));
+		mQueue.pop_front();
+	}
+
+	++mMetrics.batches;
+	if (count == mSettings.max_batch_size) ++mMetrics.full_batches;
+	mBatchedRequests += count;
+	return batch;
+}
+
+std::future<InferenceServer::result_t> InferenceServer::make_ready(result_t &&result) {
+	std::promise<result_t> promise;
+	promise.set_value(std::move(result));
+	return promise.get_future();
+}
+
+} // namespace golxzn::bot
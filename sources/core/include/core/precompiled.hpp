@@ -29,6 +29,8 @@
 #include <list>
 #include <set>
 #include <map>
+#include <deque>
+#include <random>
 
 #include <fmt/core.h>
 #include <platform_folders.h>
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <core/aliases.hpp>
+#include <core/resources/mapped_file.hpp>
+#include <core/resources/resource_view.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief The read-only archive of the assets in the single memory mapped file
+ * @details The file is formatted in the following manner (little-endian):
+ *  - header (32 bytes): [magic "GTPK" u32][version u32][entries_count u32][reserved u32]
+ *    [names_offset u64][names_size u64];
+ *  - index (32 bytes per entry) sorted by the name: [offset u64][stored_size u64][size u64]
+ *    [name_offset u32][name_length u32]. The offsets are from the beginning of the file;
+ *  - names: the relative paths of the assets with `/` separators;
+ *  - data: the contents, each at the offset aligned to `alignment`. The entry is zlib-compressed
+ *    if `stored_size` is less than `size`, otherwise it's stored as is and can be viewed without
+ *    copying, e.g. as the array of doubles.
+ */
+class asset_pack {
+public:
+	static constexpr std::string_view class_name{ "resources::asset_pack" };
+	static constexpr std::string_view extension{ ".pack" };
+	static constexpr u32 magic{ 0x4B505447 }; // "GTPK"
+	static constexpr u32 version{ 1 };
+	static constexpr size_t header_size{ 32 };
+	static constexpr size_t entry_size{ 32 };
+	static constexpr u64 alignment{ 64 }; ///< the cache line, enough for any scalar type
+
+	struct settings {
+		bool compress{ true }; ///< the entry is compressed only if it gets smaller
+		i32 level{ 6 };
+	};
+
+	asset_pack() = default;
+	explicit asset_pack(const fs::path &path);
+
+	/** @brief Pack all files of the directory recursively */
+	static bool build(const fs::path &directory, const fs::path &output, const settings &settings);
+
+	nodis bool is_open() const noexcept;
+	nodis u32 entries_count() const noexcept;
+	nodis std::string_view name(const u32 entry) const noexcept;
+
+	/** @param name the path relative to the packed directory with `/` separators */
+	nodis bool contains(const std::string_view name) const noexcept;
+
+	/** @brief The content of the entry. std::nullopt if there's no such entry */
+	nodis std::optional<std::vector<byte>> load(const std::string_view name) const;
+
+	/** @brief The view of the entry. Zero copy if the entry isn't compressed */
+	nodis resource_view view(const std::string_view name) const;
+
+private:
+	struct entry {
+		u64 offset{};
+		u64 stored_size{};
+		u64 size{};
+		u32 name_offset{};
+		u32 name_length{};
+
+		nodis bool compressed() const noexcept { return stored_size < size; }
+	};
+	static_assert(sizeof(entry) == entry_size);
+
+	sptr<const mapped_file> mMapping;
+	std::vector<entry> mEntries;
+	std::string_view mNames;
+
+	void parse();
+	nodis const entry *find(const std::string_view name) const noexcept;
+	nodis std::string_view name_of(const entry &entry) const noexcept;
+	nodis std::optional<std::vector<byte>> decompress(const entry &entry) const;
+};
+
+} // namespace golxzn::core::resources
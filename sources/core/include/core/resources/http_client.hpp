@@ -0,0 +1,109 @@
+#pragma once
+
+#include <span>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <optional>
+#include <functional>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief The HTTP/1.1 client of `http://` URLs
+ * @details The connections are kept alive and reused by the next requests to the same host.
+ * The reused connection might be closed by the server meanwhile, so the request which fails
+ * before the response begins is retried once on the new connection. The body is either
+ * collected into the response or streamed into the sink as it arrives, so the huge files never
+ * have to fit into memory. Redirects and TLS aren't supported.
+ */
+class http_client {
+public:
+	static constexpr std::string_view class_name{ "resources::http_client" };
+
+	/** @brief Gets the body in pieces. Returning false aborts the transfer */
+	using sink_t = std::function<bool(std::span<const byte>)>;
+	using headers_t = std::vector<std::pair<std::string, std::string>>;
+
+	struct settings {
+		u32 max_idle_connections{ 8 }; ///< per host
+		u32 max_concurrent_fetches{ 4 };
+		std::chrono::milliseconds timeout{ 30000 };
+		size_t buffer_size{ 64 * 1024 };
+	};
+
+	/** @brief The bytes [first, last] of the resource. No `last` means up to the end */
+	struct range {
+		u64 first{};
+		std::optional<u64> last;
+	};
+
+	struct response {
+		u16 status{}; ///< 0 if the request couldn't be made
+		headers_t headers;
+		std::vector<byte> body; ///< empty if the body was streamed into the sink
+		u64 body_size{};
+
+		nodis bool ok() const noexcept { return status >= 200 && status < 300; }
+		nodis std::optional<std::string_view> header(const std::string_view name) const noexcept;
+	};
+
+	struct stats {
+		u64 requests{};
+		u64 connections_opened{};
+		u64 connections_reused{};
+		u64 bytes_received{};
+	};
+
+	http_client();
+	explicit http_client(const settings &settings);
+	~http_client();
+
+	http_client(const http_client &) = delete;
+	http_client &operator=(const http_client &) = delete;
+
+	nodis response get(const std::string_view url, const std::optional<range> &range = std::nullopt);
+
+	/**
+	 * @brief Stream the body into the sink
+	 * @details Only the successful (2xx) body goes into the sink. The error body is collected
+	 * into the response. Resume the interrupted download with the range from the received size
+	 */
+	response get(const std::string_view url, const sink_t &sink, const std::optional<range> &range = std::nullopt);
+
+	response put(const std::string_view url, std::span<const byte> body);
+
+	/** @brief Fetch the URLs concurrently on up to `max_concurrent_fetches` connections */
+	nodis std::vector<response> get_all(std::span<const std::string> urls);
+
+	nodis stats statistics() const;
+
+private:
+	class connection;
+
+	struct endpoint {
+		std::string host;
+		u16 port{ 80 };
+		std::string target;
+
+		nodis std::string key() const;
+	};
+
+	const settings mSettings;
+	mutable std::mutex mMutex;
+	umap<std::string, std::vector<uptr<connection>>> mIdle;
+	stats mStats{};
+
+	response perform(const std::string_view method, const std::string_view url, std::span<const byte> body,
+		const sink_t *sink, const std::optional<range> &range);
+
+	uptr<connection> acquire(const endpoint &endpoint, bool &reused);
+	void release(const endpoint &endpoint, uptr<connection> connection);
+
+	static std::optional<endpoint> parse(const std::string_view url);
+};
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <mutex>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <condition_variable>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief The fixed set of threads running the blocking file operations
+ * @details The queue is bounded: `submit` waits while `max_queue_depth` jobs are pending, so
+ * the fast producer cannot queue the unlimited memory. The batch is queued under the single
+ * lock and wakes all workers at once, which is cheaper for many small jobs.
+ */
+class io_pool {
+public:
+	using job_t = std::function<void()>;
+
+	static constexpr std::string_view class_name{ "resources::io_pool" };
+
+	struct stats {
+		u64 submitted{};
+		u64 completed{};
+		u32 queue_depth{};
+		u32 peak_queue_depth{};
+	};
+
+	io_pool(const u32 threads_count, const u32 max_queue_depth);
+
+	/** @brief Finish all queued jobs and stop the workers */
+	~io_pool();
+
+	io_pool(const io_pool &) = delete;
+	io_pool &operator=(const io_pool &) = delete;
+
+	void submit(job_t job);
+	void submit(std::vector<job_t> jobs);
+
+	nodis u32 threads_count() const noexcept;
+	nodis stats statistics() const;
+
+private:
+	const u32 mMaxQueueDepth;
+	mutable std::mutex mMutex;
+	std::condition_variable mPending;
+	std::condition_variable mFreed;
+	std::deque<job_t> mQueue;
+	std::vector<std::thread> mWorkers;
+	bool mRunning{ true };
+	stats mStats{};
+
+	void work();
+};
+
+} // namespace golxzn::core::resources
@@ -1,55 +1,190 @@
 #pragma once
 
+#include <span>
+#include <future>
+#include <shared_mutex>
 #include <vector>
 #include <string>
 #include <string_view>
 #include <core/aliases.hpp>
+#include <core/resources/resource_view.hpp>
+#include <core/resources/resource_cache.hpp>
+#include <core/resources/io_pool.hpp>
+#include <core/resources/write_behind.hpp>
+#include <core/resources/asset_pack.hpp>
+#include <core/resources/memory_storage.hpp>
+#include <core/resources/http_client.hpp>
 
 namespace golxzn::core::resources {
 
 class manager {
+public:
+	enum class WriteMode {
+		Rewrite,
+		Append
+	};
+
+	using LoadHandler = std::function<std::vector<byte>(const std::string_view)>;
+	using SaveHandler = std::function<bool(const std::string_view, const byte *, const u32, const WriteMode)>;
+
+private:
 	static constexpr std::string_view class_name{ "resources::Manager" };
 	static constexpr std::string_view url_separator{ "//" };
 
-	using LoadHandler = std::function<std::vector<byte>(const std::string_view)>;
-	using SaveHandler = std::function<bool(const std::string_view, const byte *, const u32)>;
 public:
 	static constexpr std::string_view DefaultAssetsDirectory{ "assets" };
 	static constexpr std::string_view DefaultAppName{ "gtbot" };
+	static constexpr size_t DefaultCacheBudget{ 64 * 1024 * 1024 };
+	static constexpr u32 IOThreadsCount{ 4 };
+	static constexpr u32 IOQueueDepth{ 1024 };
+	static constexpr write_behind::settings WriteBehindSettings{};
 
 	static constexpr std::string_view ResourcesURL{ "res://" };
 	static constexpr std::string_view UserURL{ "user://" };
 	static constexpr std::string_view HttpURL{ "http://" };
+	static constexpr std::string_view MemoryURL{ "mem://" };
 
-	enum class WriteMode {
-		Rewrite,
-		Append
-	};
+	using load_callback = std::function<void(std::vector<byte>)>;
+	using save_callback = std::function<void(bool)>;
 
+	/**
+	 * @brief Set up the `res://` and `user://` roots
+	 * @details If the `<assets_directory_name>.pack` file is in the working directory, it's mounted
+	 * and the search of the assets directory is skipped
+	 */
 	static void initialize(const std::string_view application_name = DefaultAppName,
 		const std::string_view assets_directory_name = DefaultAssetsDirectory);
 
+	/**
+	 * @brief Look `res://` up in the pack before the assets directory
+	 * @details The pack is built by resources::asset_pack::build from the assets directory.
+	 * Mount it before loading from the other threads. The packed assets are read-only: saving
+	 * them through `res://` fails while the pack is mounted
+	 */
+	static bool mount(const fs::path &pack);
+	static void unmount();
+
+	/**
+	 * @brief Handle the URLs starting with `url` by the handlers
+	 * @details The handlers of the already registered scheme are replaced, and the built-in ones
+	 * too: load_shared and map of the replaced scheme go through the new `load`. The handlers are
+	 * copied out and called without the lock, so the slow ones don't block the registration and
+	 * they may register or unregister the schemes themselves. The replaced handler may finish its
+	 * last call
+	 * @param url the scheme with the separator, e.g. "mem://"
+	 */
+	static bool register_scheme(const std::string_view url, LoadHandler load, SaveHandler save);
+	static bool unregister_scheme(const std::string_view url);
+
+	/** @brief Drop the registered schemes and restore the built-in `res://`, `user://`, `http://` and `mem://` */
+	static void reset_schemes();
+
+	/** @brief The client of `http://`, e.g. to stream the download or to fetch many files concurrently */
+	nodis static http_client &http();
+
+	/** @brief The blobs of `mem://`. They live until they're erased or the application exits */
+	nodis static memory_storage &memory() noexcept;
+
 	static void set_write_mode(const WriteMode mode) noexcept;
 	static void reset_write_mode() noexcept;
 
 	nodis static std::vector<byte> load_binary(const std::string_view path);
 	nodis static std::string load_string(const std::string_view path);
 
+	/**
+	 * @brief Load the resource without copying it out of the cache
+	 * @details `res://` and `user://` files are cached until they're changed, `mem://` blobs are
+	 * shared as is. The other URLs are loaded every time. Returns nullptr if the resource cannot be
+	 * loaded
+	 */
+	nodis static resource_cache::content_t load_shared(const std::string_view path);
+
 	static bool save_binary(const std::string_view path, const std::vector<byte> &data);
 	static bool save_string(const std::string_view path, const std::string_view data);
 
+	/**
+	 * @brief The read-only view of the resource without copying
+	 * @details `res://` and `user://` files are memory mapped and `mem://` blobs are shared. The other
+	 * URLs are loaded into the buffer owned by the view. The view is empty if the resource cannot be
+	 * loaded
+	 */
+	nodis static resource_view map(const std::string_view path);
+
+	/**
+	 * @brief Load on the I/O pool instead of the calling thread
+	 * @details The pool has `IOThreadsCount` threads and queues up to `IOQueueDepth` jobs. The
+	 * submission waits while the queue is full. The result is the same as of `load_binary`
+	 */
+	nodis static std::future<std::vector<byte>> load_binary_async(const std::string_view path);
+	static void load_binary_async(const std::string_view path, load_callback callback);
+
+	/** @brief Load many files with the single submission. Each pool thread loads its part of them */
+	nodis static std::vector<std::future<std::vector<byte>>> load_binary_async(std::span<const std::string> paths);
+
+	/**
+	 * @brief Save on the I/O pool instead of the calling thread
+	 * @details The write mode is the one at the time of the call
+	 */
+	nodis static std::future<bool> save_binary_async(const std::string_view path, std::vector<byte> data);
+	static void save_binary_async(const std::string_view path, std::vector<byte> data, save_callback callback);
+
+	nodis static io_pool::stats io_statistics();
+
+	/**
+	 * @brief Write the buffered appends now
+	 * @details The saving in WriteMode::Append only buffers the bytes, which are written later
+	 * in the large chunks. Loading the file through the manager flushes its appends first,
+	 * but the other readers see them only after the flush. WriteMode::Rewrite replaces the
+	 * file atomically.
+	 */
+	static bool flush();
+	nodis static write_behind::stats write_statistics();
+
+	/** @brief The memory budget of the `res://` and `user://` files cache. 0 disables the cache */
+	static void set_cache_budget(const size_t bytes);
+	static void clear_cache();
+	nodis static resource_cache::stats cache_statistics();
+
+	/** @brief The filesystem path of the URL. Empty if the URL isn't backed by the filesystem */
+	nodis static fs::path resolve(const std::string_view path);
+
 private:
 	static WriteMode write_mode;
 	static fs::path assets_root;
 	static fs::path user_root;
-	static const umap<std::string_view, LoadHandler> load_handlers;
-	static const umap<std::string_view, SaveHandler> save_handlers;
+	using ShareHandler = std::function<resource_cache::content_t(const std::string_view)>;
+	using MapHandler = std::function<resource_view(const std::string_view)>;
+
+	struct scheme {
+		std::string url;
+		LoadHandler load;
+		SaveHandler save;
+		ShareHandler share; ///< optional: load_shared without copying. Falls back to `load`
+		MapHandler map; ///< optional: map without copying. Falls back to `load`
+	};
 
-	static std::vector<byte> load_from(const fs::path &path);
-	static std::vector<byte> load_from_http(const fs::path &path);
+	/// There're just a few schemes, so the linear scan of the prefixes beats hashing the substring
+	static std::shared_mutex schemes_mutex;
+	static std::vector<scheme> schemes;
+	static std::vector<scheme> builtin_schemes();
+	static memory_storage memory_blobs;
+	static resource_cache cache;
+	static sptr<const asset_pack> pack;
 
-	static bool save_to(const fs::path &path, const byte *data, const u32 size);
-	static bool save_to_http(const fs::path &path, const byte *data, const u32 size);
+	static std::vector<byte> load_from(const fs::path &path);
+	static std::optional<std::vector<byte>> load_from_pack(const std::string_view path);
+	static resource_cache::content_t load_cached(const fs::path &path);
+	static resource_cache::content_t share_file(const fs::path &path);
+	static resource_view map_file(const fs::path &path);
+	static std::vector<byte> load_from_http(const std::string_view path);
+
+	static bool save(const std::string_view path, const byte *data, const u32 size, const WriteMode mode);
+	static const scheme *find_scheme(const std::string_view path) noexcept;
+	static void report_unknown(const std::string_view path);
+	static bool save_to(const fs::path &path, const byte *data, const u32 size, const WriteMode mode);
+	static io_pool &io();
+	static write_behind &writer();
+	static bool save_to_http(const std::string_view path, const byte *data, const u32 size);
 
 	static fs::path build_path(const fs::path &prefix, const std::string_view path,
 		const std::string_view prefix_to_replace);
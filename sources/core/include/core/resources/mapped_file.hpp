@@ -0,0 +1,53 @@
+#pragma once
+
+#include <span>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief Read-only memory mapping of the whole file
+ * @details The pages are loaded by the OS on the first access and are shared with the page
+ * cache, so mapping of the huge file is instant and doesn't take any private memory.
+ * The view is valid until the object is destroyed or closed.
+ */
+class mapped_file {
+public:
+	static constexpr std::string_view class_name{ "resources::mapped_file" };
+
+	enum class access_pattern {
+		normal,
+		sequential, ///< aggressive read-ahead, the pages behind can be dropped
+		random,     ///< no read-ahead
+		will_need,  ///< start reading the pages ahead of the access
+	};
+
+	mapped_file() = default;
+	explicit mapped_file(const fs::path &path);
+	~mapped_file();
+
+	mapped_file(const mapped_file &) = delete;
+	mapped_file &operator=(const mapped_file &) = delete;
+	mapped_file(mapped_file &&other) noexcept;
+	mapped_file &operator=(mapped_file &&other) noexcept;
+
+	nodis bool is_open() const noexcept;
+	nodis std::span<const byte> data() const noexcept;
+	nodis size_t size() const noexcept;
+
+	/** @brief Hint the OS about the access to the range. Does nothing if it's not supported */
+	void advise(const access_pattern pattern, const size_t offset = 0,
+		const size_t length = (std::numeric_limits<size_t>::max)()) const noexcept;
+
+	void close() noexcept;
+
+private:
+	const byte *mData{ nullptr };
+	size_t mSize{};
+#if defined(_WIN32)
+	void *mFile{ nullptr };
+	void *mMapping{ nullptr };
+#endif
+};
+
+} // namespace golxzn::core::resources
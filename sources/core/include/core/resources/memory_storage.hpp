@@ -0,0 +1,36 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief Thread-safe blobs in RAM keyed by their URL
+ * @details It's the backend of `mem://`. The loaded blobs are shared and never change under the
+ * reader: saving replaces the blob. Appending grows the blob in place while nobody holds it and
+ * appends to the copy otherwise, so the repeated appends without the readers are amortized O(1).
+ */
+class memory_storage {
+public:
+	using content_t = sptr<const std::vector<byte>>;
+
+	nodis content_t load(const std::string_view key) const;
+	void save(const std::string_view key, const byte *data, const size_t size, const bool append);
+
+	bool erase(const std::string_view key);
+	void clear();
+
+	nodis size_t size() const; ///< the bytes of all blobs
+	nodis size_t count() const;
+
+private:
+	mutable std::mutex mMutex;
+	umap<std::string, sptr<std::vector<byte>>> mBlobs;
+	size_t mSize{};
+};
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief Thread-safe LRU cache of the file contents with the memory budget
+ * @details The entry is valid while the file has the same modification time and size, so
+ * the changed file is reloaded on the next access. The cached buffers are shared: the evicted
+ * buffer stays alive while anyone holds it, it's just not counted in the budget anymore.
+ */
+class resource_cache {
+public:
+	using content_t = sptr<const std::vector<byte>>;
+
+	static constexpr std::string_view class_name{ "resources::resource_cache" };
+
+	struct stats {
+		u64 hits{};
+		u64 misses{};
+		u64 evictions{};
+		u64 invalidations{}; ///< the entries dropped because the file was changed
+		size_t used{};
+		size_t budget{};
+		u32 entries{};
+	};
+
+	explicit resource_cache(const size_t budget) noexcept;
+
+	/** @brief The cached content if the file wasn't changed since it was inserted */
+	nodis content_t find(const std::string &key, const fs::file_time_type time, const u64 size);
+
+	/** @brief Cache the content evicting the least recently used entries. Too big content isn't cached */
+	void insert(const std::string &key, const fs::file_time_type time, const u64 size, content_t content);
+
+	void invalidate(const std::string &key);
+	void clear();
+
+	/** @brief Change the budget evicting the entries above it. 0 disables the cache */
+	void set_budget(const size_t budget);
+	nodis bool enabled() const;
+	nodis stats statistics() const;
+
+private:
+	struct entry {
+		std::string key;
+		fs::file_time_type time;
+		u64 size{};
+		content_t content;
+	};
+
+	mutable std::mutex mMutex;
+	std::list<entry> mEntries; ///< the most recently used first
+	umap<std::string, std::list<entry>::iterator> mIndex;
+	stats mStats{};
+
+	void erase(std::list<entry>::iterator entry);
+	void evict_above(const size_t budget);
+};
+
+} // namespace golxzn::core::resources
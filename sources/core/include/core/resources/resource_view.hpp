@@ -0,0 +1,45 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+#include <core/resources/mapped_file.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief Read-only bytes of the resource together with their owner
+ * @details The bytes are either the memory mapping of the file or the buffer loaded by the
+ * URL handler if the resource cannot be mapped. The copies share the same owner, so the view
+ * can be passed around without copying the bytes. The bytes are valid while any copy is alive.
+ */
+class resource_view {
+public:
+	resource_view() = default;
+	explicit resource_view(mapped_file &&mapping);
+	explicit resource_view(std::vector<byte> &&content);
+	explicit resource_view(sptr<const std::vector<byte>> content) noexcept;
+
+	/** @brief The part of the shared mapping */
+	resource_view(sptr<const mapped_file> mapping, std::span<const byte> data) noexcept;
+
+	nodis bool empty() const noexcept;
+	nodis bool is_mapped() const noexcept;
+	nodis size_t size() const noexcept;
+	nodis std::span<const byte> data() const noexcept;
+	nodis std::string_view as_string() const noexcept;
+
+	/** @brief Hint the OS about the access to the range. Does nothing for the loaded buffer */
+	void advise(const mapped_file::access_pattern pattern, const size_t offset = 0,
+		const size_t length = (std::numeric_limits<size_t>::max)()) const noexcept;
+
+	void reset() noexcept;
+
+private:
+	sptr<const mapped_file> mMapping;
+	sptr<const std::vector<byte>> mContent;
+	std::span<const byte> mData;
+};
+
+} // namespace golxzn::core::resources
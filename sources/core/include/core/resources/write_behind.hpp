@@ -0,0 +1,91 @@
+#pragma once
+
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <condition_variable>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::resources {
+
+/**
+ * @brief Coalesces the small appends to the same file into the large writes
+ * @details The appended bytes are buffered per file. The buffer is written by the background
+ * thread once it reaches `flush_size` or once its oldest bytes have waited for `flush_interval`.
+ * The writes are serialized, so the appends land in the file in the order they were made.
+ * Everything pending is written on `flush` and on the destruction.
+ */
+class write_behind {
+public:
+	using clock = std::chrono::steady_clock;
+
+	static constexpr std::string_view class_name{ "resources::write_behind" };
+
+	struct settings {
+		size_t flush_size{ 1024 * 1024 };
+		std::chrono::milliseconds flush_interval{ 1000 };
+	};
+
+	struct stats {
+		u64 appends{};
+		u64 writes{}; ///< the coalesced writes to the files
+		u64 bytes_written{};
+		size_t pending_bytes{};
+	};
+
+	explicit write_behind(const settings &settings);
+	~write_behind();
+
+	write_behind(const write_behind &) = delete;
+	write_behind &operator=(const write_behind &) = delete;
+
+	void append(const fs::path &path, const byte *data, const size_t size);
+
+	/** @brief Write the pending bytes of the file now */
+	bool flush(const fs::path &path);
+
+	/** @brief Write all pending bytes now */
+	bool flush();
+
+	/** @brief Drop the pending bytes of the file, e.g. because it's being replaced */
+	void discard(const fs::path &path);
+
+	/**
+	 * @brief Replace the file atomically
+	 * @details The content goes to the temporary file next to the target, which is renamed over
+	 * the target then, so the readers see either the old or the new file but never the torn one.
+	 * The temporary file is flushed to the disk before the rename, so it holds after a crash too.
+	 * The pending appends to the file are dropped
+	 */
+	bool replace(const fs::path &path, const byte *data, const size_t size);
+
+	nodis stats statistics() const;
+
+private:
+	struct buffer {
+		std::vector<byte> bytes;
+		clock::time_point first_append;
+	};
+
+	const settings mSettings;
+	mutable std::mutex mMutex;
+	std::mutex mWriteMutex; ///< keeps the order of the writes to the same file
+	std::condition_variable mCondition;
+	umap<std::string, buffer> mBuffers;
+	std::thread mFlusher;
+	bool mRunning{ true };
+	bool mFlushRequested{ false };
+	u64 mTemporaryCounter{};
+	stats mStats{};
+
+	void work();
+
+	template<class Predicate>
+	bool flush_if(Predicate &&predicate);
+
+	bool write(const fs::path &path, const std::vector<byte> &bytes);
+};
+
+} // namespace golxzn::core::resources
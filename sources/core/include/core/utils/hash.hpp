@@ -0,0 +1,65 @@
+#pragma once
+
+#include <span>
+#include <cstring>
+#include <core/aliases.hpp>
+
+namespace golxzn::core::utils {
+
+/**
+ * @brief The fast non-cryptographic 64-bit hash
+ * @details The xxHash64 round and avalanche over 8-byte words. It's good enough for the hash
+ * tables and the duplicate detection, but it must not be used where the input is adversarial.
+ */
+class hash final {
+public:
+	GOLXZN_STATIC_CLASS(hash);
+
+	nodis static u64 bytes(std::span<const byte> data, const u64 seed = 0) noexcept {
+		auto result{ seed + prime5 + static_cast<u64>(data.size()) };
+		size_t offset{};
+		for (; offset + sizeof(u64) <= data.size(); offset += sizeof(u64)) {
+			u64 word;
+			std::memcpy(&word, data.data() + offset, sizeof(u64));
+			result = rotl(result ^ round(word), 27) * prime1 + prime4;
+		}
+		if (offset < data.size()) {
+			u64 word{};
+			std::memcpy(&word, data.data() + offset, data.size() - offset);
+			result = rotl(result ^ round(word), 27) * prime1 + prime4;
+		}
+		return avalanche(result);
+	}
+
+	template<class T>
+	nodis static u64 values(std::span<const T> data, const u64 seed = 0) noexcept {
+		static_assert(std::is_trivially_copyable_v<T>, "Only the trivially copyable values can be hashed");
+		return bytes({ reinterpret_cast<const byte *>(data.data()), data.size_bytes() }, seed);
+	}
+
+private:
+	static constexpr u64 prime1{ 0x9E3779B185EBCA87ull };
+	static constexpr u64 prime2{ 0xC2B2AE3D27D4EB4Full };
+	static constexpr u64 prime3{ 0x165667B19E3779F9ull };
+	static constexpr u64 prime4{ 0x85EBCA77C2B2AE63ull };
+	static constexpr u64 prime5{ 0x27D4EB2F165667C5ull };
+
+	static constexpr u64 rotl(const u64 x, const int k) noexcept {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	static constexpr u64 round(const u64 word) noexcept {
+		return rotl(word * prime2, 31) * prime1;
+	}
+
+	static constexpr u64 avalanche(u64 value) noexcept {
+		value ^= value >> 33;
+		value *= prime2;
+		value ^= value >> 29;
+		value *= prime3;
+		value ^= value >> 32;
+		return value;
+	}
+};
+
+} // namespace golxzn::core::utils
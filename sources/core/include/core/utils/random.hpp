@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <random>
 #include <core/aliases.hpp>
 
@@ -21,6 +22,77 @@ public:
 		Distribution distribution{ min, max };
 		return distribution(engine);
 	}
+
+	nodis static u64 seed() noexcept {
+		static std::random_device device{};
+		return (static_cast<u64>(device()) << 32) ^ device();
+	}
+};
+
+/**
+ * @brief The xoshiro256** engine
+ * @details Much faster than std::mt19937_64 and has only 32 bytes of state. Together with
+ * `bounded` and `shuffle` it gives the same sequence for the same seed on every platform,
+ * which isn't guaranteed by the std distributions.
+ */
+class xoshiro256 final {
+public:
+	using result_type = u64;
+
+	constexpr explicit xoshiro256(u64 seed) noexcept {
+		/// splitmix64 spreads the seed over the whole state
+		for (auto &value : mState) {
+			seed += 0x9E3779B97F4A7C15ull;
+			auto z{ seed };
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+			value = z ^ (z >> 31);
+		}
+	}
+
+	nodis static constexpr result_type min() noexcept { return 0; }
+	nodis static constexpr result_type (max)() noexcept { return (std::numeric_limits<result_type>::max)(); }
+
+	constexpr result_type operator()() noexcept {
+		const auto result{ rotl(mState[1] * 5, 7) * 9 };
+		const auto t{ mState[1] << 17 };
+		mState[2] ^= mState[0];
+		mState[3] ^= mState[1];
+		mState[1] ^= mState[2];
+		mState[0] ^= mState[3];
+		mState[2] ^= t;
+		mState[3] = rotl(mState[3], 45);
+		return result;
+	}
+
+	/** @brief The uniform value in [0, bound) without the modulo bias */
+	constexpr u32 bounded(const u32 bound) noexcept {
+		/// Lemire's multiply-shift with the rejection of the biased low part
+		auto product{ (operator()() >> 32) * bound };
+		if (auto low{ static_cast<u32>(product) }; low < bound) {
+			const auto threshold{ static_cast<u32>(-bound) % bound };
+			while (low < threshold) {
+				product = (operator()() >> 32) * bound;
+				low = static_cast<u32>(product);
+			}
+		}
+		return static_cast<u32>(product >> 32);
+	}
+
+	/** @brief Fisher-Yates shuffle */
+	template<class T>
+	constexpr void shuffle(std::span<T> values) noexcept {
+		for (auto i{ values.size() }; i > 1; --i) {
+			std::swap(values[i - 1], values[bounded(static_cast<u32>(i))]);
+		}
+	}
+
+private:
+	u64 mState[4]{};
+
+	static constexpr u64 rotl(const u64 x, const int k) noexcept {
+		return (x << k) | (x >> (64 - k));
+	}
 };
 
 } // namespace golxzn::core::utils
@@ -0,0 +1,228 @@
+#include <zlib.h>
+#include "core/common"
+#include "core/resources/asset_pack.hpp"
+
+namespace golxzn::core::resources {
+
+namespace {
+
+template<class T>
+void write_value(std::vector<byte> &output, size_t &offset, const T value) noexcept {
+	std::memcpy(output.data() + offset, &value, sizeof(T));
+	offset += sizeof(T);
+}
+
+template<class T>
+T read_value(std::span<const byte> input, size_t &offset) noexcept {
+	T value{};
+	std::memcpy(&value, input.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+} // anonymous namespace
+
+asset_pack::asset_pack(const fs::path &path) : mMapping{ std::make_shared<const mapped_file>(path) } {
+	parse();
+}
+
+bool asset_pack::build(const fs::path &directory, const fs::path &output, const settings &settings) {
+	if (!fs::is_directory(directory)) [[unlikely]] {
+		spdlog::error("[{}]: '{}' isn't a directory", class_name, directory.string());
+		return false;
+	}
+
+	std::error_code error;
+	std::vector<std::pair<std::string, fs::path>> files;
+	for (const auto &file : fs::recursive_directory_iterator{ directory }) {
+		if (!file.is_regular_file() || fs::equivalent(file.path(), output, error)) continue;
+		files.emplace_back(fs::relative(file.path(), directory).generic_string(), file.path());
+	}
+	std::ranges::sort(files, {}, &std::pair<std::string, fs::path>::first);
+	if (files.size() > (std::numeric_limits<u32>::max)()) [[unlikely]] return false;
+
+	std::string names;
+	std::vector<entry> entries(files.size());
+	for (size_t i{}; i < files.size(); ++i) {
+		entries[i].name_offset = static_cast<u32>(names.size());
+		entries[i].name_length = static_cast<u32>(files[i].first.size());
+		names += files[i].first;
+	}
+
+	const auto names_offset{ header_size + entries.size() * entry_size };
+	fs::ofstream file{ output, std::ios::binary | std::ios::trunc };
+	if (!file.is_open()) [[unlikely]] {
+		spdlog::error("[{}]: Cannot open '{}'", class_name, output.string());
+		return false;
+	}
+
+	/// The index is written once the sizes are known
+	std::vector<byte> head(names_offset);
+	file.write(reinterpret_cast<const char *>(head.data()), head.size());
+	file.write(names.data(), names.size());
+
+	auto offset{ static_cast<u64>(names_offset + names.size()) };
+	std::vector<byte> compressed;
+	const std::array<char, alignment> padding{};
+	for (size_t i{}; i < files.size(); ++i) {
+		const auto aligned{ (offset + alignment - 1) / alignment * alignment };
+		file.write(padding.data(), static_cast<std::streamsize>(aligned - offset));
+		offset = aligned;
+
+		const mapped_file source{ files[i].second };
+		/// The empty file isn't mapped, but it's still the valid empty entry
+		if (!source.is_open() && fs::file_size(files[i].second, error) != 0) [[unlikely]] {
+			spdlog::error("[{}]: Cannot read '{}'", class_name, files[i].second.string());
+			return false;
+		}
+		auto content{ source.data() };
+		entries[i].offset = offset;
+		entries[i].size = content.size();
+
+		if (settings.compress && !content.empty()) {
+			auto compressed_size{ compressBound(static_cast<uLong>(content.size())) };
+			compressed.resize(compressed_size);
+			const auto status{ compress2(compressed.data(), &compressed_size,
+				content.data(), static_cast<uLong>(content.size()), settings.level) };
+			if (status == Z_OK && compressed_size < content.size()) {
+				content = { compressed.data(), static_cast<size_t>(compressed_size) };
+			}
+		}
+		entries[i].stored_size = content.size();
+		file.write(reinterpret_cast<const char *>(content.data()), content.size());
+		offset += content.size();
+	}
+
+	size_t position{};
+	write_value(head, position, magic);
+	write_value(head, position, version);
+	write_value(head, position, static_cast<u32>(entries.size()));
+	write_value(head, position, u32{});
+	write_value(head, position, static_cast<u64>(names_offset));
+	write_value(head, position, static_cast<u64>(names.size()));
+	for (const auto &entry : entries) {
+		write_value(head, position, entry.offset);
+		write_value(head, position, entry.stored_size);
+		write_value(head, position, entry.size);
+		write_value(head, position, entry.name_offset);
+		write_value(head, position, entry.name_length);
+	}
+	file.seekp(0);
+	file.write(reinterpret_cast<const char *>(head.data()), head.size());
+	file.close();
+	if (!file) [[unlikely]] {
+		spdlog::error("[{}]: Cannot write '{}'", class_name, output.string());
+		return false;
+	}
+	return true;
+}
+
+bool asset_pack::is_open() const noexcept { return mMapping != nullptr && mMapping->is_open(); }
+u32 asset_pack::entries_count() const noexcept { return static_cast<u32>(mEntries.size()); }
+
+std::string_view asset_pack::name(const u32 entry) const noexcept {
+	return entry < mEntries.size() ? name_of(mEntries[entry]) : std::string_view{};
+}
+
+bool asset_pack::contains(const std::string_view name) const noexcept {
+	return find(name) != nullptr;
+}
+
+std::optional<std::vector<byte>> asset_pack::load(const std::string_view name) const {
+	const auto found{ find(name) };
+	if (found == nullptr) return std::nullopt;
+	if (found->compressed()) return decompress(*found);
+
+	const auto content{ mMapping->data().subspan(found->offset, found->size) };
+	return std::vector<byte>{ std::begin(content), std::end(content) };
+}
+
+resource_view asset_pack::view(const std::string_view name) const {
+	const auto found{ find(name) };
+	if (found == nullptr) return {};
+	if (!found->compressed()) {
+		return resource_view{ mMapping, mMapping->data().subspan(found->offset, found->size) };
+	}
+	if (auto content{ decompress(*found) }; content.has_value()) {
+		return resource_view{ std::move(*content) };
+	}
+	return {};
+}
+
+void asset_pack::parse() {
+	const auto bytes{ mMapping->data() };
+	if (bytes.size() < header_size) [[unlikely]] {
+		spdlog::error("[{}]: The pack is too small", class_name);
+		return;
+	}
+
+	size_t position{};
+	const auto file_magic{ read_value<u32>(bytes, position) };
+	const auto file_version{ read_value<u32>(bytes, position) };
+	if (file_magic != magic || file_version != version) [[unlikely]] {
+		spdlog::error("[{}]: Unsupported format {:#x} version {}", class_name, file_magic, file_version);
+		return;
+	}
+	const auto count{ read_value<u32>(bytes, position) };
+	position += sizeof(u32); // reserved
+	const auto names_offset{ read_value<u64>(bytes, position) };
+	const auto names_size{ read_value<u64>(bytes, position) };
+	if (header_size + static_cast<u64>(count) * entry_size > names_offset
+			|| names_offset > bytes.size() || names_size > bytes.size() - names_offset) [[unlikely]] {
+		spdlog::error("[{}]: The index is truncated", class_name);
+		return;
+	}
+
+	std::vector<entry> entries(count);
+	for (auto &entry : entries) {
+		entry.offset = read_value<u64>(bytes, position);
+		entry.stored_size = read_value<u64>(bytes, position);
+		entry.size = read_value<u64>(bytes, position);
+		entry.name_offset = read_value<u32>(bytes, position);
+		entry.name_length = read_value<u32>(bytes, position);
+		if (entry.offset > bytes.size() || entry.stored_size > bytes.size() - entry.offset
+				|| static_cast<u64>(entry.name_offset) + entry.name_length > names_size) [[unlikely]] {
+			spdlog::error("[{}]: The entry is out of the pack", class_name);
+			return;
+		}
+	}
+
+	/// find() looks the names up by the binary search
+	const std::string_view names{ reinterpret_cast<const char *>(bytes.data() + names_offset), static_cast<size_t>(names_size) };
+	const auto unsorted{ std::ranges::adjacent_find(entries, std::greater_equal{}, [names](const entry &entry) {
+		return names.substr(entry.name_offset, entry.name_length);
+	}) };
+	if (unsorted != std::end(entries)) [[unlikely]] {
+		spdlog::error("[{}]: The index isn't sorted by the names", class_name);
+		return;
+	}
+	mNames = names;
+	mEntries = std::move(entries);
+	mMapping->advise(mapped_file::access_pattern::random);
+}
+
+const asset_pack::entry *asset_pack::find(const std::string_view name) const noexcept {
+	const auto found{ std::ranges::lower_bound(mEntries, name, {}, [this](const entry &entry) {
+		return name_of(entry);
+	}) };
+	if (found == std::end(mEntries) || name_of(*found) != name) return nullptr;
+	return &*found;
+}
+
+std::string_view asset_pack::name_of(const entry &entry) const noexcept {
+	return mNames.substr(entry.name_offset, entry.name_length);
+}
+
+std::optional<std::vector<byte>> asset_pack::decompress(const entry &entry) const {
+	std::vector<byte> content(entry.size);
+	auto size{ static_cast<uLongf>(entry.size) };
+	const auto status{ uncompress(content.data(), &size,
+		mMapping->data().data() + entry.offset, static_cast<uLong>(entry.stored_size)) };
+	if (status != Z_OK || size != entry.size) [[unlikely]] {
+		spdlog::error("[{}]: Cannot decompress '{}' ({})", class_name, name_of(entry), status);
+		return std::nullopt;
+	}
+	return content;
+}
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,475 @@
+#include <cctype>
+#include <atomic>
+#include <thread>
+#include <charconv>
+#include "core/common"
+#include "core/resources/http_client.hpp"
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <winsock2.h>
+#	include <ws2tcpip.h>
+#else
+#	include <netdb.h>
+#	include <unistd.h>
+#	include <sys/socket.h>
+#	include <sys/time.h>
+#	include <netinet/in.h>
+#	include <netinet/tcp.h>
+#endif
+
+namespace golxzn::core::resources {
+
+namespace {
+
+#if defined(_WIN32)
+using socket_t = SOCKET;
+constexpr socket_t invalid_socket{ INVALID_SOCKET };
+
+void close_socket(const socket_t socket) noexcept { closesocket(socket); }
+
+void set_timeout(const socket_t socket, const std::chrono::milliseconds timeout) noexcept {
+	const auto value{ static_cast<DWORD>(timeout.count()) };
+	setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&value), sizeof(value));
+	setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void initialize_sockets() {
+	static const auto initialized{ [] {
+		WSADATA data{};
+		return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+	}() };
+	if (!initialized) [[unlikely]] {
+		spdlog::error("[{}]: Cannot initialize the sockets", http_client::class_name);
+	}
+}
+#else
+using socket_t = int;
+constexpr socket_t invalid_socket{ -1 };
+
+void close_socket(const socket_t socket) noexcept { ::close(socket); }
+
+void set_timeout(const socket_t socket, const std::chrono::milliseconds timeout) noexcept {
+	timeval value{};
+	value.tv_sec = static_cast<decltype(value.tv_sec)>(timeout.count() / 1000);
+	value.tv_usec = static_cast<decltype(value.tv_usec)>((timeout.count() % 1000) * 1000);
+	setsockopt(socket, SOL_SOCKET, SO_RCVTIMEO, &value, sizeof(value));
+	setsockopt(socket, SOL_SOCKET, SO_SNDTIMEO, &value, sizeof(value));
+}
+
+void initialize_sockets() {}
+#endif
+
+#if defined(MSG_NOSIGNAL)
+constexpr int send_flags{ MSG_NOSIGNAL }; // the closed connection mustn't kill the process with SIGPIPE
+#else
+constexpr int send_flags{ 0 };
+#endif
+
+constexpr size_t max_line_length{ 64 * 1024 };
+
+bool iequals(const std::string_view lhs, const std::string_view rhs) noexcept {
+	return std::ranges::equal(lhs, rhs, [](const char l, const char r) {
+		return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+	});
+}
+
+std::string_view trim(std::string_view value) noexcept {
+	while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+	while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+	return value;
+}
+
+template<class T>
+std::optional<T> to_number(const std::string_view value, const int base = 10) noexcept {
+	T result{};
+	const auto [end, error]{ std::from_chars(value.data(), value.data() + value.size(), result, base) };
+	if (error != std::errc{} || end == value.data()) return std::nullopt;
+	return result;
+}
+
+} // anonymous namespace
+
+class http_client::connection {
+public:
+	connection(const socket_t socket, const size_t buffer_size) : mSocket{ socket }, mBuffer(buffer_size) {}
+	~connection() { close_socket(mSocket); }
+
+	connection(const connection &) = delete;
+	connection &operator=(const connection &) = delete;
+
+	static uptr<connection> open(const endpoint &endpoint, const settings &settings) {
+		addrinfo hints{};
+		hints.ai_family = AF_UNSPEC;
+		hints.ai_socktype = SOCK_STREAM;
+		addrinfo *addresses{ nullptr };
+		const auto port{ std::to_string(endpoint.port) };
+		if (getaddrinfo(endpoint.host.c_str(), port.c_str(), &hints, &addresses) != 0) [[unlikely]] {
+			spdlog::error("[{}]: Cannot resolve '{}'", class_name, endpoint.host);
+			return nullptr;
+		}
+
+		socket_t result{ invalid_socket };
+		for (auto address{ addresses }; address != nullptr; address = address->ai_next) {
+			result = ::socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+			if (result == invalid_socket) continue;
+
+			set_timeout(result, settings.timeout);
+			if (::connect(result, address->ai_addr, static_cast<int>(address->ai_addrlen)) == 0) break;
+			close_socket(result);
+			result = invalid_socket;
+		}
+		freeaddrinfo(addresses);
+		if (result == invalid_socket) [[unlikely]] {
+			spdlog::error("[{}]: Cannot connect to '{}'", class_name, endpoint.key());
+			return nullptr;
+		}
+
+		const int enabled{ 1 };
+		setsockopt(result, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&enabled), sizeof(enabled));
+		return std::make_unique<connection>(result, std::max<size_t>(settings.buffer_size, 4096));
+	}
+
+	bool write(std::span<const byte> data) noexcept {
+		while (!data.empty()) {
+			const auto sent{ ::send(mSocket, reinterpret_cast<const char *>(data.data()),
+				static_cast<int>(std::min<size_t>(data.size(), (std::numeric_limits<int>::max)())), send_flags) };
+			if (sent <= 0) return false;
+			data = data.subspan(static_cast<size_t>(sent));
+		}
+		return true;
+	}
+
+	bool write(const std::string_view data) noexcept {
+		return write({ reinterpret_cast<const byte *>(data.data()), data.size() });
+	}
+
+	/** @brief The line without CRLF. std::nullopt if the connection is closed or the line is too long */
+	std::optional<std::string> read_line() {
+		std::string line;
+		for (;;) {
+			if (mBegin == mEnd && !fill()) return std::nullopt;
+
+			const auto begin{ mBuffer.data() + mBegin };
+			const auto end{ mBuffer.data() + mEnd };
+			const auto found{ std::find(begin, end, byte{ '\n' }) };
+			line.append(reinterpret_cast<const char *>(begin), static_cast<size_t>(found - begin));
+			if (line.size() > max_line_length) [[unlikely]] return std::nullopt;
+			if (found != end) {
+				mBegin += static_cast<size_t>(found - begin) + 1;
+				if (!line.empty() && line.back() == '\r') line.pop_back();
+				return line;
+			}
+			mBegin = mEnd;
+		}
+	}
+
+	/** @brief Pass exactly `count` bytes into the sink */
+	bool read(u64 count, const sink_t &sink) {
+		while (count != 0) {
+			if (mBegin == mEnd && !fill()) return false;
+
+			const auto size{ static_cast<size_t>(std::min<u64>(count, mEnd - mBegin)) };
+			const auto accepted{ sink({ mBuffer.data() + mBegin, size }) };
+			mBegin += size;
+			count -= size;
+			if (!accepted) return false;
+		}
+		return true;
+	}
+
+	/** @brief Pass everything until the server closes the connection into the sink */
+	bool read_until_close(const sink_t &sink) {
+		for (;;) {
+			if (mBegin == mEnd && !fill()) return mClosed;
+			const auto accepted{ sink({ mBuffer.data() + mBegin, mEnd - mBegin }) };
+			mBegin = mEnd;
+			if (!accepted) return false;
+		}
+	}
+
+private:
+	socket_t mSocket;
+	std::vector<byte> mBuffer;
+	size_t mBegin{};
+	size_t mEnd{};
+	bool mClosed{ false };
+
+	bool fill() noexcept {
+		const auto received{ ::recv(mSocket, reinterpret_cast<char *>(mBuffer.data()), static_cast<int>(mBuffer.size()), 0) };
+		if (received <= 0) {
+			mClosed = received == 0;
+			return false;
+		}
+		mBegin = 0;
+		mEnd = static_cast<size_t>(received);
+		return true;
+	}
+};
+
+std::optional<std::string_view> http_client::response::header(const std::string_view name) const noexcept {
+	for (const auto &[key, value] : headers) {
+		if (iequals(key, name)) return value;
+	}
+	return std::nullopt;
+}
+
+std::string http_client::endpoint::key() const {
+	if (host.find(':') != std::string::npos) return fmt::format("[{}]:{}", host, port);
+	return fmt::format("{}:{}", host, port);
+}
+
+http_client::http_client() : http_client{ settings{} } {}
+
+http_client::http_client(const settings &settings) : mSettings{ settings } {
+	initialize_sockets();
+}
+
+http_client::~http_client() = default;
+
+http_client::response http_client::get(const std::string_view url, const std::optional<range> &range) {
+	return perform("GET", url, {}, nullptr, range);
+}
+
+http_client::response http_client::get(const std::string_view url, const sink_t &sink, const std::optional<range> &range) {
+	return perform("GET", url, {}, &sink, range);
+}
+
+http_client::response http_client::put(const std::string_view url, std::span<const byte> body) {
+	return perform("PUT", url, body, nullptr, std::nullopt);
+}
+
+std::vector<http_client::response> http_client::get_all(std::span<const std::string> urls) {
+	std::vector<response> responses(urls.size());
+	std::atomic<size_t> next{};
+	{
+		const auto workers_count{ std::min<size_t>(urls.size(), (std::max)(mSettings.max_concurrent_fetches, u32{ 1 })) };
+		std::vector<std::jthread> workers;
+		workers.reserve(workers_count);
+		for (size_t worker{}; worker < workers_count; ++worker) {
+			workers.emplace_back([&] {
+				for (auto i{ next++ }; i < urls.size(); i = next++) {
+					responses[i] = get(urls[i]);
+				}
+			});
+		}
+	}
+	return responses;
+}
+
+http_client::stats http_client::statistics() const {
+	std::lock_guard lock{ mMutex };
+	return mStats;
+}
+
+http_client::response http_client::perform(const std::string_view method, const std::string_view url,
+		std::span<const byte> body, const sink_t *sink, const std::optional<range> &range) {
+	const auto endpoint{ parse(url) };
+	if (!endpoint.has_value()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid URL '{}'", class_name, url);
+		return {};
+	}
+
+	auto request{ fmt::format("{} {} HTTP/1.1\r\nHost: {}\r\nUser-Agent: gtbot\r\nConnection: keep-alive\r\n",
+		method, endpoint->target, endpoint->key()) };
+	if (range.has_value()) {
+		request += range->last.has_value()
+			? fmt::format("Range: bytes={}-{}\r\n", range->first, *range->last)
+			: fmt::format("Range: bytes={}-\r\n", range->first);
+	}
+	if (!body.empty() || method == "PUT") {
+		request += fmt::format("Content-Length: {}\r\n", body.size());
+	}
+	request += "\r\n";
+
+	{
+		std::lock_guard lock{ mMutex };
+		++mStats.requests;
+	}
+
+	/// The kept alive connection might be closed by the server, so the request is retried once
+	/// if nothing has been received yet
+	for (int attempt{}; attempt < 2; ++attempt) {
+		bool reused{ false };
+		auto connection{ acquire(*endpoint, reused) };
+		if (connection == nullptr) [[unlikely]] return {};
+		const bool can_retry{ reused && attempt == 0 };
+
+		if (!connection->write(request) || (!body.empty() && !connection->write(body))) {
+			if (can_retry) continue;
+			spdlog::error("[{}]: Cannot send the request to '{}'", class_name, url);
+			return {};
+		}
+
+		auto status_line{ connection->read_line() };
+		if (!status_line.has_value()) {
+			if (can_retry) continue;
+			spdlog::error("[{}]: No response from '{}'", class_name, url);
+			return {};
+		}
+
+		response result;
+		bool keep_alive{};
+		for (;;) {
+			const std::string_view status{ *status_line };
+			const auto version_end{ status.find(' ') };
+			if (!status.starts_with("HTTP/1.") || version_end == status.npos) [[unlikely]] {
+				spdlog::error("[{}]: Invalid status line '{}' from '{}'", class_name, status, url);
+				return {};
+			}
+			result.status = to_number<u16>(status.substr(version_end + 1, 3)).value_or(0);
+			keep_alive = status.starts_with("HTTP/1.1");
+
+			for (auto line{ connection->read_line() }; ; line = connection->read_line()) {
+				if (!line.has_value()) [[unlikely]] {
+					spdlog::error("[{}]: The headers from '{}' are truncated", class_name, url);
+					return {};
+				}
+				if (line->empty()) break;
+
+				const std::string_view header{ *line };
+				const auto separator{ header.find(':') };
+				if (separator == header.npos) continue;
+				result.headers.emplace_back(trim(header.substr(0, separator)), trim(header.substr(separator + 1)));
+			}
+
+			/// The interim responses, e.g. 100 Continue or 103 Early Hints, have no body and precede
+			/// the final one. The 101 Switching Protocols is final, but it's never requested
+			if (result.status / 100 != 1 || result.status == 101) break;
+
+			result = {};
+			status_line = connection->read_line();
+			if (!status_line.has_value()) [[unlikely]] {
+				spdlog::error("[{}]: No final response from '{}'", class_name, url);
+				return {};
+			}
+		}
+		if (const auto value{ result.header("Connection") }; value.has_value()) {
+			keep_alive = iequals(*value, "keep-alive") || (keep_alive && !iequals(*value, "close"));
+		}
+
+		const sink_t collect{ [&result](std::span<const byte> data) {
+			result.body.insert(std::end(result.body), std::begin(data), std::end(data));
+			return true;
+		} };
+		const sink_t &target{ sink != nullptr && result.ok() ? *sink : collect };
+		const sink_t counted{ [&result, &target](std::span<const byte> data) {
+			result.body_size += data.size();
+			return target(data);
+		} };
+
+		bool complete{ true };
+		const auto transfer_encoding{ result.header("Transfer-Encoding") };
+		const auto content_length{ result.header("Content-Length") };
+		if (method == "HEAD" || result.status == 204 || result.status == 304 || result.status / 100 == 1) {
+			// no body
+		} else if (transfer_encoding.has_value() && iequals(*transfer_encoding, "chunked")) {
+			for (;;) {
+				const auto size_line{ connection->read_line() };
+				const auto size{ size_line.has_value()
+					? to_number<u64>(trim(std::string_view{ *size_line }.substr(0, size_line->find(';'))), 16)
+					: std::nullopt };
+				if (!size.has_value()) {
+					complete = false;
+					break;
+				}
+				if (*size == 0) {
+					/// The trailer headers up to the empty line
+					for (auto trailer{ connection->read_line() }; trailer.has_value() && !trailer->empty();
+						trailer = connection->read_line()) {}
+					break;
+				}
+				if (!connection->read(*size, counted) || !connection->read_line().has_value()) {
+					complete = false;
+					break;
+				}
+			}
+		} else if (content_length.has_value()) {
+			const auto length{ to_number<u64>(*content_length) };
+			complete = length.has_value() && connection->read(*length, counted);
+		} else {
+			complete = connection->read_until_close(counted);
+			keep_alive = false;
+		}
+
+		{
+			std::lock_guard lock{ mMutex };
+			mStats.bytes_received += result.body_size;
+		}
+		if (!complete) [[unlikely]] {
+			spdlog::error("[{}]: The body from '{}' is incomplete ({} bytes received)", class_name, url, result.body_size);
+			result.status = 0;
+			return result;
+		}
+		if (keep_alive) {
+			release(*endpoint, std::move(connection));
+		}
+		return result;
+	}
+	return {};
+}
+
+uptr<http_client::connection> http_client::acquire(const endpoint &endpoint, bool &reused) {
+	{
+		std::lock_guard lock{ mMutex };
+		if (auto found{ mIdle.find(endpoint.key()) }; found != std::end(mIdle) && !found->second.empty()) {
+			auto connection{ std::move(found->second.back()) };
+			found->second.pop_back();
+			++mStats.connections_reused;
+			reused = true;
+			return connection;
+		}
+	}
+
+	reused = false;
+	auto connection{ connection::open(endpoint, mSettings) };
+	if (connection != nullptr) {
+		std::lock_guard lock{ mMutex };
+		++mStats.connections_opened;
+	}
+	return connection;
+}
+
+void http_client::release(const endpoint &endpoint, uptr<connection> connection) {
+	std::lock_guard lock{ mMutex };
+	if (auto &idle{ mIdle[endpoint.key()] }; idle.size() < mSettings.max_idle_connections) {
+		idle.emplace_back(std::move(connection));
+	}
+}
+
+std::optional<http_client::endpoint> http_client::parse(const std::string_view url) {
+	static constexpr std::string_view scheme{ "http://" };
+	if (!url.starts_with(scheme)) return std::nullopt;
+
+	const auto rest{ url.substr(scheme.size()) };
+	const auto authority{ rest.substr(0, rest.find_first_of("/?#")) };
+	if (authority.empty()) return std::nullopt;
+
+	endpoint result;
+	result.target = std::string{ rest.substr(authority.size()) };
+	if (const auto fragment{ result.target.find('#') }; fragment != std::string::npos) {
+		result.target.erase(fragment);
+	}
+	if (result.target.empty() || result.target.front() != '/') {
+		result.target.insert(0, 1, '/');
+	}
+
+	/// [ipv6]:port or host:port
+	const auto port_separator{ authority.rfind(':') };
+	const auto ipv6_end{ authority.rfind(']') };
+	if (port_separator != authority.npos && (ipv6_end == authority.npos || port_separator > ipv6_end)) {
+		const auto port{ to_number<u16>(authority.substr(port_separator + 1)) };
+		if (!port.has_value()) return std::nullopt;
+		result.port = *port;
+		result.host = std::string{ authority.substr(0, port_separator) };
+	} else {
+		result.host = std::string{ authority };
+	}
+	if (result.host.size() > 2 && result.host.front() == '[' && result.host.back() == ']') {
+		result.host = result.host.substr(1, result.host.size() - 2);
+	}
+	return result;
+}
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,87 @@
+#include "core/common"
+#include "core/resources/io_pool.hpp"
+
+namespace golxzn::core::resources {
+
+io_pool::io_pool(const u32 threads_count, const u32 max_queue_depth)
+	: mMaxQueueDepth{ (std::max)(max_queue_depth, u32{ 1 }) } {
+	const auto count{ (std::max)(threads_count, u32{ 1 }) };
+	mWorkers.reserve(count);
+	for (u32 i{}; i < count; ++i) {
+		mWorkers.emplace_back(&io_pool::work, this);
+	}
+}
+
+io_pool::~io_pool() {
+	{
+		std::lock_guard lock{ mMutex };
+		mRunning = false;
+	}
+	mPending.notify_all();
+	for (auto &worker : mWorkers) {
+		if (worker.joinable()) worker.join();
+	}
+}
+
+void io_pool::submit(job_t job) {
+	{
+		std::unique_lock lock{ mMutex };
+		mFreed.wait(lock, [this] { return mQueue.size() < mMaxQueueDepth; });
+		mQueue.emplace_back(std::move(job));
+		++mStats.submitted;
+		mStats.peak_queue_depth = (std::max)(mStats.peak_queue_depth, static_cast<u32>(mQueue.size()));
+	}
+	mPending.notify_one();
+}
+
+void io_pool::submit(std::vector<job_t> jobs) {
+	for (auto job{ std::begin(jobs) }; job != std::end(jobs);) {
+		{
+			std::unique_lock lock{ mMutex };
+			mFreed.wait(lock, [this] { return mQueue.size() < mMaxQueueDepth; });
+			const auto count{ std::min<size_t>(mMaxQueueDepth - mQueue.size(), std::distance(job, std::end(jobs))) };
+			std::move(job, job + count, std::back_inserter(mQueue));
+			job += count;
+			mStats.submitted += count;
+			mStats.peak_queue_depth = (std::max)(mStats.peak_queue_depth, static_cast<u32>(mQueue.size()));
+		}
+		mPending.notify_all();
+	}
+}
+
+u32 io_pool::threads_count() const noexcept { return static_cast<u32>(mWorkers.size()); }
+
+io_pool::stats io_pool::statistics() const {
+	std::lock_guard lock{ mMutex };
+	auto stats{ mStats };
+	stats.queue_depth = static_cast<u32>(mQueue.size());
+	return stats;
+}
+
+void io_pool::work() {
+	for (;;) {
+		job_t job;
+		{
+			std::unique_lock lock{ mMutex };
+			mPending.wait(lock, [this] { return !mQueue.empty() || !mRunning; });
+			if (mQueue.empty()) return; // stopped
+
+			job = std::move(mQueue.front());
+			mQueue.pop_front();
+		}
+		mFreed.notify_one();
+
+		try {
+			job();
+		} catch (const std::exception &error) {
+			spdlog::error("[{}]: The job failed: {}", class_name, error.what());
+		} catch (...) {
+			spdlog::error("[{}]: The job failed", class_name);
+		}
+
+		std::lock_guard lock{ mMutex };
+		++mStats.completed;
+	}
+}
+
+} // namespace golxzn::core::resources
@@ -1,32 +1,169 @@
 #include "core/common"
 #include "core/resources/manager.hpp"
+#include "core/resources/mapped_file.hpp"
 
 namespace golxzn::core::resources {
 
+namespace {
+
+/** @brief Run the job on the I/O thread. Its exception is passed to the future instead of terminating */
+template<class T, class Job>
+void fulfill(std::promise<T> &promise, Job &&job) noexcept {
+	try {
+		promise.set_value(job());
+	} catch (...) {
+		promise.set_exception(std::current_exception());
+	}
+}
+
+/** @brief Run the job and the callback on the I/O thread. Nothing they throw leaves the thread */
+template<class Callback, class Job>
+void call_back(const Callback &callback, Job &&job, const std::string_view owner, const std::string_view path) noexcept {
+	try {
+		callback(job());
+	} catch (const std::exception &error) {
+		spdlog::error("[{}]: The asynchronous job for '{}' failed: {}", owner, path, error.what());
+	} catch (...) {
+		spdlog::error("[{}]: The asynchronous job for '{}' failed", owner, path);
+	}
+}
+
+} // anonymous namespace
+
 manager::WriteMode manager::write_mode{ manager::WriteMode::Rewrite };
 fs::path manager::assets_root{ fs::current_path() };
 fs::path manager::user_root{ fs::path{ sago::getDataHome() } };
+resource_cache manager::cache{ manager::DefaultCacheBudget };
+sptr<const asset_pack> manager::pack;
 
-const umap<std::string_view, manager::LoadHandler> manager::load_handlers{
-	{ manager::ResourcesURL, [](const std::string_view path) { return manager::load_from(manager::build_path(manager::assets_root, path, manager::ResourcesURL)); } },
-	{ manager::UserURL,      [](const std::string_view path) { return manager::load_from(manager::build_path(manager::user_root, path, manager::UserURL)); } },
-	{ manager::HttpURL,      [](const std::string_view path) { return manager::load_from_http(path); } },
-};
+memory_storage manager::memory_blobs;
+std::shared_mutex manager::schemes_mutex;
+std::vector<manager::scheme> manager::schemes{ manager::builtin_schemes() };
 
-const umap<std::string_view, manager::SaveHandler> manager::save_handlers{
-	{ manager::ResourcesURL, [](auto path, auto data, const auto size) { return manager::save_to(manager::build_path(manager::assets_root, path, manager::ResourcesURL), data, size); } },
-	{ manager::UserURL,      [](auto path, auto data, const auto size) { return manager::save_to(manager::build_path(manager::user_root, path, manager::UserURL), data, size); } },
-	{ manager::HttpURL,      [](auto path, auto data, const auto size) { return manager::save_to_http(path, data, size); } },
-};
+std::vector<manager::scheme> manager::builtin_schemes() {
+	return {
+		{
+			std::string{ manager::ResourcesURL },
+			[](const std::string_view path) {
+				if (auto content{ manager::load_from_pack(path) }; content.has_value()) return std::move(*content);
+				return manager::load_from(manager::build_path(manager::assets_root, path, manager::ResourcesURL));
+			},
+			[](auto path, auto data, const auto size, const auto mode) {
+				/// The loads would keep returning the packed entry instead of the saved file
+				if (manager::pack != nullptr && manager::pack->contains(path.substr(manager::ResourcesURL.size()))) {
+					spdlog::error("[{}]: Cannot save '{}': the asset is read from the mounted pack", manager::class_name, path);
+					return false;
+				}
+				return manager::save_to(manager::build_path(manager::assets_root, path, manager::ResourcesURL), data, size, mode);
+			},
+			[](const std::string_view path) {
+				if (auto content{ manager::load_from_pack(path) }; content.has_value()) {
+					return std::make_shared<const std::vector<byte>>(std::move(*content));
+				}
+				return manager::share_file(manager::build_path(manager::assets_root, path, manager::ResourcesURL));
+			},
+			[](const std::string_view path) {
+				if (manager::pack != nullptr) {
+					if (auto view{ manager::pack->view(path.substr(manager::ResourcesURL.size())) }; !view.empty())
+						return view;
+				}
+				return manager::map_file(manager::build_path(manager::assets_root, path, manager::ResourcesURL));
+			},
+		},
+		{
+			std::string{ manager::UserURL },
+			[](const std::string_view path) { return manager::load_from(manager::build_path(manager::user_root, path, manager::UserURL)); },
+			[](auto path, auto data, const auto size, const auto mode) { return manager::save_to(manager::build_path(manager::user_root, path, manager::UserURL), data, size, mode); },
+			[](const std::string_view path) { return manager::share_file(manager::build_path(manager::user_root, path, manager::UserURL)); },
+			[](const std::string_view path) { return manager::map_file(manager::build_path(manager::user_root, path, manager::UserURL)); },
+		},
+		{
+			std::string{ manager::HttpURL },
+			[](const std::string_view path) { return manager::load_from_http(path); },
+			[](auto path, auto data, const auto size, auto) { return manager::save_to_http(path, data, size); },
+			nullptr,
+			nullptr,
+		},
+		{
+			std::string{ manager::MemoryURL },
+			[](const std::string_view path) {
+				if (const auto content{ manager::memory_blobs.load(path) }; content != nullptr) return *content;
+				return std::vector<byte>{};
+			},
+			[](auto path, auto data, const auto size, const auto mode) {
+				manager::memory_blobs.save(path, data, size, mode == WriteMode::Append);
+				return true;
+			},
+			[](const std::string_view path) { return manager::memory_blobs.load(path); },
+			[](const std::string_view path) { return resource_view{ manager::memory_blobs.load(path) }; },
+		},
+	};
+}
 
 
 void manager::initialize(const std::string_view application_name, const std::string_view assets_directory_name) {
 	spdlog::info("[{}] Initializing with {} and {}",
 		class_name, application_name, assets_directory_name);
-	setup_assets_root(assets_directory_name);
+	const fs::path assets_name{ assets_directory_name.empty() ? DefaultAssetsDirectory : assets_directory_name };
+	auto pack_path{ fs::current_path() / assets_name };
+	pack_path += asset_pack::extension;
+	if (mount(pack_path)) {
+		assets_root = fs::current_path() / assets_name;
+	} else {
+		setup_assets_root(assets_directory_name);
+	}
 	setup_user_root(application_name);
 }
 
+bool manager::mount(const fs::path &pack_path) {
+	if (!fs::is_regular_file(pack_path))
+		return false;
+
+	auto mounted{ std::make_shared<const asset_pack>(pack_path) };
+	if (!mounted->is_open() || mounted->entries_count() == 0) {
+		spdlog::error("[{}]: Cannot mount '{}'", class_name, pack_path.string());
+		return false;
+	}
+	spdlog::info("[{}]: Mounted '{}' with {} assets", class_name, pack_path.string(), mounted->entries_count());
+	pack = std::move(mounted);
+	return true;
+}
+
+void manager::unmount() { pack.reset(); }
+
+bool manager::register_scheme(const std::string_view url, LoadHandler load, SaveHandler save) {
+	if (!url.ends_with(url_separator) || url.size() <= url_separator.size() || !load || !save) [[unlikely]] {
+		spdlog::error("[{}]: Invalid scheme '{}'", class_name, url);
+		return false;
+	}
+
+	std::unique_lock lock{ schemes_mutex };
+	const auto found{ std::ranges::find(schemes, url, &scheme::url) };
+	if (found != std::end(schemes)) {
+		/// The zero-copy handlers of the replaced scheme would bypass the new load
+		found->load = std::move(load);
+		found->save = std::move(save);
+		found->share = nullptr;
+		found->map = nullptr;
+		return true;
+	}
+	schemes.push_back(scheme{ std::string{ url }, std::move(load), std::move(save), nullptr, nullptr });
+	return true;
+}
+
+bool manager::unregister_scheme(const std::string_view url) {
+	std::unique_lock lock{ schemes_mutex };
+	return std::erase_if(schemes, [url](const scheme &scheme) { return scheme.url == url; }) != 0;
+}
+
+void manager::reset_schemes() {
+	auto builtin{ builtin_schemes() };
+	std::unique_lock lock{ schemes_mutex };
+	schemes = std::move(builtin);
+}
+
+memory_storage &manager::memory() noexcept { return memory_blobs; }
+
 void manager::set_write_mode(const WriteMode mode) noexcept { write_mode = mode; }
 void manager::reset_write_mode() noexcept { write_mode = WriteMode::Rewrite; }
 
@@ -34,17 +171,16 @@ std::vector<byte> manager::load_binary(const std::string_view path) {
 	if (path.empty())
 		return {};
 
-	if (const auto url_pos{ path.find(url_separator) }; url_pos != path.npos) {
-		const auto url{ path.substr(0, url_pos + url_separator.size()) };
-		if (const auto &found{ load_handlers.find(url) }; found != std::end(load_handlers)) {
-			return found->second(path);
-		} else {
-			spdlog::error("[{}]: Unknown URL: '{}' in path '{}'", class_name, url, path);
-		}
+	LoadHandler load;
+	{
+		std::shared_lock lock{ schemes_mutex };
+		if (const auto found{ find_scheme(path) }; found != nullptr) load = found->load;
+	}
+	if (!load) {
+		report_unknown(path);
 		return {};
 	}
-	spdlog::error("[{}]: Cannot find URL in path '{}'", class_name, path);
-	return {};
+	return load(path);
 }
 
 std::string manager::load_string(const std::string_view path) {
@@ -53,58 +189,244 @@ std::string manager::load_string(const std::string_view path) {
 	return {};
 }
 
-bool manager::save_binary(const std::string_view path, const std::vector<byte> &data) {
-	if (path.empty() || data.empty())
-		return false;
+resource_cache::content_t manager::load_shared(const std::string_view path) {
+	if (path.empty())
+		return nullptr;
 
-	if (const auto url_pos{ path.find(url_separator) }; url_pos != path.npos) {
-		const auto url{ path.substr(0, url_pos + url_separator.size()) };
-		if (const auto &found{ save_handlers.find(url) }; found != std::end(save_handlers)) {
-			return found->second(path, data.data(), data.size());
-		} else {
-			spdlog::error("[{}]: Unknown URL: '{}' in path '{}'", class_name, url, path);
+	LoadHandler load;
+	ShareHandler share;
+	{
+		std::shared_lock lock{ schemes_mutex };
+		if (const auto found{ find_scheme(path) }; found != nullptr) {
+			load = found->load;
+			share = found->share;
 		}
-		return false;
 	}
-	spdlog::error("[{}]: Cannot find URL in path '{}'", class_name, path);
-	return false;
+	if (share) return share(path);
+	if (!load) {
+		report_unknown(path);
+		return nullptr;
+	}
+	if (auto content{ load(path) }; !content.empty()) {
+		return std::make_shared<const std::vector<byte>>(std::move(content));
+	}
+	return nullptr;
+}
+
+bool manager::save_binary(const std::string_view path, const std::vector<byte> &data) {
+	return save(path, data.data(), static_cast<u32>(data.size()), write_mode);
 }
 bool manager::save_string(const std::string_view path, const std::string_view data) {
-	if (path.empty() || data.empty())
-		return false;
+	return save(path, reinterpret_cast<const byte *>(data.data()), static_cast<u32>(data.size()), write_mode);
+}
 
-	if (const auto url_pos{ path.find(url_separator) }; url_pos != path.npos) {
-		const auto url{ path.substr(0, url_pos + url_separator.size()) };
-		if (const auto &found{ save_handlers.find(url) }; found != std::end(save_handlers)) {
-			return found->second(path, reinterpret_cast<const byte *>(data.data()), data.size());
-		} else {
-			spdlog::error("[{}]: Unknown URL: '{}' in path '{}'", class_name, url, path);
+std::future<std::vector<byte>> manager::load_binary_async(const std::string_view path) {
+	auto promise{ std::make_shared<std::promise<std::vector<byte>>>() };
+	auto future{ promise->get_future() };
+	io().submit([promise, path = std::string{ path }] { fulfill(*promise, [&path] { return load_binary(path); }); });
+	return future;
+}
+
+void manager::load_binary_async(const std::string_view path, load_callback callback) {
+	io().submit([callback = std::move(callback), path = std::string{ path }] {
+		call_back(callback, [&path] { return load_binary(path); }, class_name, path);
+	});
+}
+
+std::vector<std::future<std::vector<byte>>> manager::load_binary_async(std::span<const std::string> paths) {
+	using promises_t = std::vector<std::promise<std::vector<byte>>>;
+	auto promises{ std::make_shared<promises_t>(paths.size()) };
+	auto shared_paths{ std::make_shared<const std::vector<std::string>>(std::begin(paths), std::end(paths)) };
+
+	std::vector<std::future<std::vector<byte>>> futures;
+	futures.reserve(paths.size());
+	for (auto &promise : *promises) {
+		futures.emplace_back(promise.get_future());
+	}
+
+	const auto jobs_count{ std::min<size_t>(paths.size(), io().threads_count()) };
+	std::vector<io_pool::job_t> jobs;
+	jobs.reserve(jobs_count);
+	for (size_t job{}; job < jobs_count; ++job) {
+		const auto begin{ paths.size() * job / jobs_count };
+		const auto end{ paths.size() * (job + 1) / jobs_count };
+		jobs.emplace_back([promises, shared_paths, begin, end] {
+			for (auto i{ begin }; i < end; ++i) {
+				fulfill((*promises)[i], [&path = (*shared_paths)[i]] { return load_binary(path); });
+			}
+		});
+	}
+	io().submit(std::move(jobs));
+	return futures;
+}
+
+std::future<bool> manager::save_binary_async(const std::string_view path, std::vector<byte> data) {
+	auto promise{ std::make_shared<std::promise<bool>>() };
+	auto future{ promise->get_future() };
+	io().submit([promise, path = std::string{ path }, data = std::move(data), mode = write_mode] {
+		fulfill(*promise, [&] { return save(path, data.data(), static_cast<u32>(data.size()), mode); });
+	});
+	return future;
+}
+
+void manager::save_binary_async(const std::string_view path, std::vector<byte> data, save_callback callback) {
+	io().submit([callback = std::move(callback), path = std::string{ path }, data = std::move(data), mode = write_mode] {
+		call_back(callback, [&] { return save(path, data.data(), static_cast<u32>(data.size()), mode); }, class_name, path);
+	});
+}
+
+io_pool::stats manager::io_statistics() { return io().statistics(); }
+
+bool manager::flush() { return writer().flush(); }
+write_behind::stats manager::write_statistics() { return writer().statistics(); }
+
+resource_view manager::map(const std::string_view path) {
+	if (path.empty())
+		return {};
+
+	LoadHandler load;
+	MapHandler map;
+	{
+		std::shared_lock lock{ schemes_mutex };
+		if (const auto found{ find_scheme(path) }; found != nullptr) {
+			load = found->load;
+			map = found->map;
 		}
-		return false;
 	}
-	spdlog::error("[{}]: Cannot find URL in path '{}'", class_name, path);
-	return false;
+	if (map) return map(path);
+	if (!load) {
+		report_unknown(path);
+		return {};
+	}
+	return resource_view{ load(path) };
+}
+
+void manager::set_cache_budget(const size_t bytes) { cache.set_budget(bytes); }
+void manager::clear_cache() { cache.clear(); }
+resource_cache::stats manager::cache_statistics() { return cache.statistics(); }
+
+fs::path manager::resolve(const std::string_view path) {
+	if (path.starts_with(ResourcesURL)) {
+		return build_path(assets_root, path, ResourcesURL);
+	}
+	if (path.starts_with(UserURL)) {
+		return build_path(user_root, path, UserURL);
+	}
+	spdlog::error("[{}]: Cannot resolve '{}' to the filesystem path", class_name, path);
+	return {};
 }
 
 std::vector<byte> manager::load_from(const fs::path &path) {
-	if (!fs::exists(path) || !fs::is_regular_file(path))
+	writer().flush(path);
+	std::error_code error;
+	const auto size{ fs::file_size(path, error) };
+	if (error || size == 0)
 		return {};
 
-	if (fs::bifstream file{ path, std::ios::binary | std::ios::ate }; file.is_open()) {
-		const auto size{ file.tellg() };
-		file.seekg(std::ios::beg);
-		std::vector<byte> content(size, byte{});
-		file.read(&content[0], size);
+	/// The files above the budget would never be cached, so they skip the cache entirely
+	const auto cached{ cache.enabled() && size <= cache.statistics().budget };
+	const auto time{ cached ? fs::last_write_time(path, error) : fs::file_time_type{} };
+	if (error)
+		return {};
+	const auto key{ cached ? path.string() : std::string{} };
+	if (cached) {
+		if (const auto content{ cache.find(key, time, size) }; content != nullptr)
+			return *content;
+	}
+
+	/// The single copy from the page cache without the stream buffering and seeking
+	const mapped_file file{ path };
+	if (!file.is_open())
+		return {};
+	const auto data{ file.data() };
+	std::vector<byte> content{ std::begin(data), std::end(data) };
+	if (cached) {
+		/// The loaded buffer is returned, the cache gets its own shared copy
+		cache.insert(key, time, size, std::make_shared<const std::vector<byte>>(content));
+	}
+	return content;
+}
+
+resource_cache::content_t manager::share_file(const fs::path &path) {
+	writer().flush(path);
+	return load_cached(path);
+}
+
+resource_view manager::map_file(const fs::path &path) {
+	writer().flush(path);
+	if (!fs::is_regular_file(path))
+		return {};
+	return resource_view{ mapped_file{ path } };
+}
+
+std::optional<std::vector<byte>> manager::load_from_pack(const std::string_view path) {
+	if (pack == nullptr || !path.starts_with(ResourcesURL))
+		return std::nullopt;
+	return pack->load(path.substr(ResourcesURL.size()));
+}
+
+resource_cache::content_t manager::load_cached(const fs::path &path) {
+	std::error_code error;
+	const auto size{ fs::file_size(path, error) };
+	if (error || size == 0)
+		return nullptr;
+	const auto time{ fs::last_write_time(path, error) };
+	if (error)
+		return nullptr;
+
+	const auto key{ path.string() };
+	if (auto content{ cache.find(key, time, size) }; content != nullptr)
 		return content;
+
+	const mapped_file file{ path };
+	if (!file.is_open())
+		return nullptr;
+	const auto data{ file.data() };
+	auto content{ std::make_shared<const std::vector<byte>>(std::begin(data), std::end(data)) };
+	cache.insert(key, time, size, content);
+	return content;
+}
+std::vector<byte> manager::load_from_http(const std::string_view path) {
+	auto response{ http().get(path) };
+	if (!response.ok()) {
+		spdlog::error("[{}]: Cannot load '{}' (status {})", class_name, path, response.status);
+		return {};
 	}
-	return {};
+	return std::move(response.body);
 }
-std::vector<byte> manager::load_from_http(const fs::path &path) {
-	spdlog::error("[{}]: load_from_http isn't implemented yet", class_name);
-	return {};
+
+bool manager::save(const std::string_view path, const byte *data, const u32 size, const WriteMode mode) {
+	if (path.empty() || data == nullptr || size == 0)
+		return false;
+
+	SaveHandler save;
+	{
+		std::shared_lock lock{ schemes_mutex };
+		if (const auto found{ find_scheme(path) }; found != nullptr) save = found->save;
+	}
+	if (!save) {
+		report_unknown(path);
+		return false;
+	}
+	return save(path, data, size, mode);
+}
+
+const manager::scheme *manager::find_scheme(const std::string_view path) noexcept {
+	for (const auto &scheme : schemes) {
+		if (path.starts_with(scheme.url)) return &scheme;
+	}
+	return nullptr;
+}
+
+void manager::report_unknown(const std::string_view path) {
+	if (const auto url_pos{ path.find(url_separator) }; url_pos != path.npos) {
+		spdlog::error("[{}]: Unknown URL: '{}' in path '{}'", class_name, path.substr(0, url_pos + url_separator.size()), path);
+		return;
+	}
+	spdlog::error("[{}]: Cannot find URL in path '{}'", class_name, path);
 }
 
-bool manager::save_to(const fs::path &path, const byte *data, const u32 size) {
+bool manager::save_to(const fs::path &path, const byte *data, const u32 size, const WriteMode mode) {
 	if (!path.has_filename() || size == 0 || data == nullptr)
 		return false;
 
@@ -112,21 +434,43 @@ bool manager::save_to(const fs::path &path, const byte *data, const u32 size) {
 		fs::create_directories(parent_path);
 	}
 
-	const std::ios::openmode mode{
-		std::ios::binary | (write_mode == WriteMode::Append ? std::ios::app : std::ios::trunc)
-	};
-	if (fs::bofstream file{ path, mode }; file.is_open()) {
-		file.write(data, size);
+	if (mode == WriteMode::Append) {
+		writer().append(path, data, size);
+		return true;
+	}
+	if (writer().replace(path, data, size)) {
+		cache.invalidate(path.string());
 		return true;
 	}
-
 	return false;
 }
-bool manager::save_to_http(const fs::path &path, const byte *data, const u32 size) {
-	if (!path.has_filename() || size == 0 || data == nullptr)
+bool manager::save_to_http(const std::string_view path, const byte *data, const u32 size) {
+	if (size == 0 || data == nullptr)
 		return false;
-	spdlog::error("[{}]: save_to_http isn't implemented yet", class_name);
-	return false;
+
+	if (const auto response{ http().put(path, { data, size }) }; !response.ok()) {
+		spdlog::error("[{}]: Cannot save '{}' (status {})", class_name, path, response.status);
+		return false;
+	}
+	return true;
+}
+
+http_client &manager::http() {
+	static http_client client;
+	return client;
+}
+
+io_pool &manager::io() {
+	/// The queued jobs use them, so they're constructed first to be destroyed after the pool drains
+	writer();
+	std::ignore = http();
+	static io_pool pool{ IOThreadsCount, IOQueueDepth };
+	return pool;
+}
+
+write_behind &manager::writer() {
+	static write_behind instance{ WriteBehindSettings };
+	return instance;
 }
 
 fs::path manager::build_path(const fs::path &prefix, const std::string_view path,
@@ -0,0 +1,147 @@
+#include "core/common"
+#include "core/resources/mapped_file.hpp"
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <unistd.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#endif
+
+namespace golxzn::core::resources {
+
+#if defined(_WIN32)
+
+mapped_file::mapped_file(const fs::path &path) {
+	/// The other writers and the atomic replace (rename over the file) must not be blocked by the view
+	mFile = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (mFile == INVALID_HANDLE_VALUE) [[unlikely]] {
+		mFile = nullptr;
+		spdlog::error("[{}]: Cannot open '{}'", class_name, path.string());
+		return;
+	}
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(mFile, &size) || size.QuadPart == 0) [[unlikely]] {
+		close();
+		return;
+	}
+
+	mMapping = CreateFileMappingW(mFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mMapping == nullptr) [[unlikely]] {
+		spdlog::error("[{}]: Cannot map '{}' ({})", class_name, path.string(), GetLastError());
+		close();
+		return;
+	}
+	mData = static_cast<const byte *>(MapViewOfFile(mMapping, FILE_MAP_READ, 0, 0, 0));
+	if (mData == nullptr) [[unlikely]] {
+		spdlog::error("[{}]: Cannot map '{}' ({})", class_name, path.string(), GetLastError());
+		close();
+		return;
+	}
+	mSize = static_cast<size_t>(size.QuadPart);
+}
+
+void mapped_file::advise(const access_pattern pattern, const size_t offset, const size_t length) const noexcept {
+	if (pattern != access_pattern::will_need || offset >= mSize) return;
+
+	WIN32_MEMORY_RANGE_ENTRY range{
+		const_cast<byte *>(mData + offset), std::min(length, mSize - offset)
+	};
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+void mapped_file::close() noexcept {
+	if (mData != nullptr) UnmapViewOfFile(mData);
+	if (mMapping != nullptr) CloseHandle(mMapping);
+	if (mFile != nullptr) CloseHandle(mFile);
+	mData = nullptr;
+	mMapping = mFile = nullptr;
+	mSize = 0;
+}
+
+#else
+
+mapped_file::mapped_file(const fs::path &path) {
+	const auto file{ ::open(path.c_str(), O_RDONLY | O_CLOEXEC) };
+	if (file < 0) [[unlikely]] {
+		spdlog::error("[{}]: Cannot open '{}'", class_name, path.string());
+		return;
+	}
+
+	struct stat info{};
+	if (::fstat(file, &info) != 0 || info.st_size <= 0) [[unlikely]] {
+		::close(file);
+		return;
+	}
+
+	const auto size{ static_cast<size_t>(info.st_size) };
+	const auto data{ ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0) };
+	::close(file); // the mapping keeps the file alive
+	if (data == MAP_FAILED) [[unlikely]] {
+		spdlog::error("[{}]: Cannot map '{}' ({})", class_name, path.string(), std::strerror(errno));
+		return;
+	}
+	mData = static_cast<const byte *>(data);
+	mSize = size;
+}
+
+void mapped_file::advise(const access_pattern pattern, const size_t offset, const size_t length) const noexcept {
+	if (mData == nullptr || offset >= mSize) return;
+
+	/// madvise requires the page-aligned address
+	static const auto page_size{ static_cast<size_t>(::sysconf(_SC_PAGESIZE)) };
+	const auto begin{ offset / page_size * page_size };
+	const auto end{ offset + std::min(length, mSize - offset) };
+
+	int advice{ MADV_NORMAL };
+	switch (pattern) {
+		case access_pattern::sequential: advice = MADV_SEQUENTIAL; break;
+		case access_pattern::random: advice = MADV_RANDOM; break;
+		case access_pattern::will_need: advice = MADV_WILLNEED; break;
+		default: break;
+	}
+	::madvise(const_cast<byte *>(mData + begin), end - begin, advice);
+}
+
+void mapped_file::close() noexcept {
+	if (mData != nullptr) {
+		::munmap(const_cast<byte *>(mData), mSize);
+	}
+	mData = nullptr;
+	mSize = 0;
+}
+
+#endif
+
+mapped_file::~mapped_file() {
+	close();
+}
+
+mapped_file::mapped_file(mapped_file &&other) noexcept {
+	*this = std::move(other);
+}
+
+mapped_file &mapped_file::operator=(mapped_file &&other) noexcept {
+	if (this == &other) return *this;
+
+	close();
+	std::swap(mData, other.mData);
+	std::swap(mSize, other.mSize);
+#if defined(_WIN32)
+	std::swap(mFile, other.mFile);
+	std::swap(mMapping, other.mMapping);
+#endif
+	return *this;
+}
+
+bool mapped_file::is_open() const noexcept { return mData != nullptr; }
+std::span<const byte> mapped_file::data() const noexcept { return { mData, mSize }; }
+size_t mapped_file::size() const noexcept { return mSize; }
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,61 @@
+#include "core/common"
+#include "core/resources/memory_storage.hpp"
+
+namespace golxzn::core::resources {
+
+memory_storage::content_t memory_storage::load(const std::string_view key) const {
+	std::lock_guard lock{ mMutex };
+	if (const auto found{ mBlobs.find(std::string{ key }) }; found != std::end(mBlobs)) {
+		return found->second;
+	}
+	return nullptr;
+}
+
+void memory_storage::save(const std::string_view key, const byte *data, const size_t size, const bool append) {
+	std::lock_guard lock{ mMutex };
+	auto &blob{ mBlobs[std::string{ key }] };
+	if (blob == nullptr || !append) {
+		if (blob != nullptr) mSize -= blob->size();
+		blob = std::make_shared<std::vector<byte>>(data, data + size);
+		mSize += size;
+		return;
+	}
+
+	/// The loads take the lock too, so the single owner here means nobody reads the blob
+	if (blob.use_count() != 1) {
+		auto copy{ std::make_shared<std::vector<byte>>() };
+		copy->reserve(blob->size() + size);
+		copy->assign(std::begin(*blob), std::end(*blob));
+		blob = std::move(copy);
+	}
+	blob->insert(std::end(*blob), data, data + size);
+	mSize += size;
+}
+
+bool memory_storage::erase(const std::string_view key) {
+	std::lock_guard lock{ mMutex };
+	const auto found{ mBlobs.find(std::string{ key }) };
+	if (found == std::end(mBlobs)) return false;
+
+	mSize -= found->second->size();
+	mBlobs.erase(found);
+	return true;
+}
+
+void memory_storage::clear() {
+	std::lock_guard lock{ mMutex };
+	mBlobs.clear();
+	mSize = 0;
+}
+
+size_t memory_storage::size() const {
+	std::lock_guard lock{ mMutex };
+	return mSize;
+}
+
+size_t memory_storage::count() const {
+	std::lock_guard lock{ mMutex };
+	return mBlobs.size();
+}
+
+} // namespace golxzn::core::resources
@@ -0,0 +1,93 @@
+#include "core/common"
+#include "core/resources/resource_cache.hpp"
+
+namespace golxzn::core::resources {
+
+resource_cache::resource_cache(const size_t budget) noexcept {
+	mStats.budget = budget;
+}
+
+resource_cache::content_t resource_cache::find(const std::string &key, const fs::file_time_type time, const u64 size) {
+	std::lock_guard lock{ mMutex };
+	const auto found{ mIndex.find(key) };
+	if (found == std::end(mIndex)) {
+		++mStats.misses;
+		return nullptr;
+	}
+
+	const auto entry{ found->second };
+	if (entry->time != time || entry->size != size) [[unlikely]] {
+		++mStats.invalidations;
+		++mStats.misses;
+		erase(entry);
+		return nullptr;
+	}
+
+	++mStats.hits;
+	mEntries.splice(std::begin(mEntries), mEntries, entry);
+	return entry->content;
+}
+
+void resource_cache::insert(const std::string &key, const fs::file_time_type time, const u64 size, content_t content) {
+	if (content == nullptr) [[unlikely]] return;
+
+	std::lock_guard lock{ mMutex };
+	if (const auto found{ mIndex.find(key) }; found != std::end(mIndex)) {
+		erase(found->second);
+	}
+	if (content->size() > mStats.budget) return;
+
+	evict_above(mStats.budget - content->size());
+	mStats.used += content->size();
+	mEntries.push_front(entry{ key, time, size, std::move(content) });
+	mIndex.emplace(key, std::begin(mEntries));
+	mStats.entries = static_cast<u32>(mEntries.size());
+}
+
+void resource_cache::invalidate(const std::string &key) {
+	std::lock_guard lock{ mMutex };
+	if (const auto found{ mIndex.find(key) }; found != std::end(mIndex)) {
+		++mStats.invalidations;
+		erase(found->second);
+	}
+}
+
+void resource_cache::clear() {
+	std::lock_guard lock{ mMutex };
+	mEntries.clear();
+	mIndex.clear();
+	mStats.used = 0;
+	mStats.entries = 0;
+}
+
+void resource_cache::set_budget(const size_t budget) {
+	std::lock_guard lock{ mMutex };
+	mStats.budget = budget;
+	evict_above(budget);
+}
+
+bool resource_cache::enabled() const {
+	std::lock_guard lock{ mMutex };
+	return mStats.budget != 0;
+}
+
+resource_cache::stats resource_cache::statistics() const {
+	std::lock_guard lock{ mMutex };
+	return mStats;
+}
+
+void resource_cache::erase(std::list<entry>::iterator entry) {
+	mStats.used -= entry->content->size();
+	mIndex.erase(entry->key);
+	mEntries.erase(entry);
+	mStats.entries = static_cast<u32>(mEntries.size());
+}
+
+void resource_cache::evict_above(const size_t budget) {
+	while (mStats.used > budget && !mEntries.empty()) {
+		++mStats.evictions;
+		erase(std::prev(std::end(mEntries)));
+	}
+}
+
+} // namespace golxzn::core::resources
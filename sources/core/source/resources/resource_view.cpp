@@ -0,0 +1,55 @@
+#include "core/common"
+#include "core/resources/resource_view.hpp"
+
+namespace golxzn::core::resources {
+
+resource_view::resource_view(mapped_file &&mapping) {
+	if (!mapping.is_open()) [[unlikely]] return;
+
+	mMapping = std::make_shared<const mapped_file>(std::move(mapping));
+	mData = mMapping->data();
+}
+
+resource_view::resource_view(std::vector<byte> &&content) {
+	if (content.empty()) [[unlikely]] return;
+
+	mContent = std::make_shared<const std::vector<byte>>(std::move(content));
+	mData = *mContent;
+}
+
+resource_view::resource_view(sptr<const std::vector<byte>> content) noexcept {
+	if (content == nullptr || content->empty()) [[unlikely]] return;
+
+	mContent = std::move(content);
+	mData = *mContent;
+}
+
+resource_view::resource_view(sptr<const mapped_file> mapping, std::span<const byte> data) noexcept
+	: mMapping{ std::move(mapping) }, mData{ data } {
+	if (mMapping == nullptr || mData.empty()) [[unlikely]] reset();
+}
+
+bool resource_view::empty() const noexcept { return mData.empty(); }
+bool resource_view::is_mapped() const noexcept { return mMapping != nullptr; }
+size_t resource_view::size() const noexcept { return mData.size(); }
+std::span<const byte> resource_view::data() const noexcept { return mData; }
+
+std::string_view resource_view::as_string() const noexcept {
+	return { reinterpret_cast<const char *>(mData.data()), mData.size() };
+}
+
+void resource_view::advise(const mapped_file::access_pattern pattern, const size_t offset,
+		const size_t length) const noexcept {
+	if (mMapping == nullptr || offset >= mData.size()) return;
+
+	const auto view_offset{ static_cast<size_t>(mData.data() - mMapping->data().data()) };
+	mMapping->advise(pattern, view_offset + offset, std::min(length, mData.size() - offset));
+}
+
+void resource_view::reset() noexcept {
+	mMapping.reset();
+	mContent.reset();
+	mData = {};
+}
+
+} // namespace golxzn::core::resources
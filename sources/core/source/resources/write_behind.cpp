@@ -0,0 +1,213 @@
+#include "core/common"
+#include "core/resources/write_behind.hpp"
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <windows.h>
+#else
+#	include <cerrno>
+#	include <fcntl.h>
+#	include <unistd.h>
+#endif
+
+namespace golxzn::core::resources {
+
+namespace {
+
+#if defined(_WIN32)
+
+/** @brief Write the new file and flush it to the disk, so the rename never exposes the empty file after a crash */
+bool write_durably(const fs::path &path, const byte *data, const size_t size) {
+	const auto file{ CreateFileW(path.wstring().c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (file == INVALID_HANDLE_VALUE) [[unlikely]] return false;
+
+	bool written{ true };
+	for (size_t offset{}; written && offset < size;) {
+		DWORD chunk{};
+		const auto wanted{ static_cast<DWORD>(std::min<size_t>(size - offset, MAXDWORD)) };
+		written = WriteFile(file, data + offset, wanted, &chunk, nullptr) != FALSE;
+		offset += chunk;
+	}
+	written = written && FlushFileBuffers(file) != FALSE;
+	return CloseHandle(file) != FALSE && written;
+}
+
+/** @brief NTFS journals the rename itself */
+void sync_directory(const fs::path &) {}
+
+#else
+
+bool write_durably(const fs::path &path, const byte *data, const size_t size) {
+	const auto file{ ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644) };
+	if (file < 0) [[unlikely]] return false;
+
+	bool written{ true };
+	for (size_t offset{}; written && offset < size;) {
+		const auto chunk{ ::write(file, data + offset, size - offset) };
+		written = chunk > 0 || (chunk < 0 && errno == EINTR);
+		offset += static_cast<size_t>((std::max)(chunk, ssize_t{ 0 }));
+	}
+	written = written && ::fsync(file) == 0;
+	return ::close(file) == 0 && written;
+}
+
+/** @brief Make the rename itself durable */
+void sync_directory(const fs::path &directory) {
+	if (const auto file{ ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY | O_CLOEXEC) }; file >= 0) {
+		::fsync(file);
+		::close(file);
+	}
+}
+
+#endif
+
+} // anonymous namespace
+
+write_behind::write_behind(const settings &settings)
+	: mSettings{ settings }, mFlusher{ &write_behind::work, this } {}
+
+write_behind::~write_behind() {
+	{
+		std::lock_guard lock{ mMutex };
+		mRunning = false;
+	}
+	mCondition.notify_all();
+	if (mFlusher.joinable()) mFlusher.join();
+	flush();
+}
+
+void write_behind::append(const fs::path &path, const byte *data, const size_t size) {
+	if (data == nullptr || size == 0) [[unlikely]] return;
+
+	bool full{ false };
+	{
+		std::lock_guard lock{ mMutex };
+		auto &pending{ mBuffers[path.string()] };
+		if (pending.bytes.empty()) {
+			pending.first_append = clock::now();
+		}
+		pending.bytes.insert(std::end(pending.bytes), data, data + size);
+		++mStats.appends;
+		mStats.pending_bytes += size;
+		full = pending.bytes.size() >= mSettings.flush_size;
+		mFlushRequested |= full;
+	}
+	if (full) mCondition.notify_one();
+}
+
+bool write_behind::flush(const fs::path &path) {
+	const auto key{ path.string() };
+	return flush_if([&key](const std::string &file, const buffer &) { return file == key; });
+}
+
+bool write_behind::flush() {
+	return flush_if([](const std::string &, const buffer &) { return true; });
+}
+
+void write_behind::discard(const fs::path &path) {
+	std::lock_guard write_lock{ mWriteMutex };
+	std::lock_guard lock{ mMutex };
+	if (const auto found{ mBuffers.find(path.string()) }; found != std::end(mBuffers)) {
+		mStats.pending_bytes -= found->second.bytes.size();
+		mBuffers.erase(found);
+	}
+}
+
+bool write_behind::replace(const fs::path &path, const byte *data, const size_t size) {
+	/// No flush may append the older bytes between dropping them and the rename
+	std::lock_guard write_lock{ mWriteMutex };
+
+	fs::path temporary{ path };
+	{
+		std::lock_guard lock{ mMutex };
+		if (const auto found{ mBuffers.find(path.string()) }; found != std::end(mBuffers)) {
+			mStats.pending_bytes -= found->second.bytes.size();
+			mBuffers.erase(found);
+		}
+		temporary += fmt::format(".{}.tmp", mTemporaryCounter++);
+	}
+
+	std::error_code error;
+	if (!write_durably(temporary, data, size)) [[unlikely]] {
+		spdlog::error("[{}]: Cannot write '{}'", class_name, temporary.string());
+		fs::remove(temporary, error);
+		return false;
+	}
+
+	fs::rename(temporary, path, error);
+	if (error) [[unlikely]] {
+		spdlog::error("[{}]: Cannot replace '{}': {}", class_name, path.string(), error.message());
+		fs::remove(temporary, error);
+		return false;
+	}
+	sync_directory(path.parent_path());
+
+	std::lock_guard lock{ mMutex };
+	++mStats.writes;
+	mStats.bytes_written += size;
+	return true;
+}
+
+write_behind::stats write_behind::statistics() const {
+	std::lock_guard lock{ mMutex };
+	return mStats;
+}
+
+void write_behind::work() {
+	std::unique_lock lock{ mMutex };
+	while (mRunning) {
+		mCondition.wait_for(lock, mSettings.flush_interval, [this] { return mFlushRequested || !mRunning; });
+		if (!mRunning) return;
+		mFlushRequested = false;
+
+		lock.unlock();
+		const auto deadline{ clock::now() - mSettings.flush_interval };
+		flush_if([this, deadline](const std::string &, const buffer &pending) {
+			return pending.bytes.size() >= mSettings.flush_size || pending.first_append <= deadline;
+		});
+		lock.lock();
+	}
+}
+
+template<class Predicate>
+bool write_behind::flush_if(Predicate &&predicate) {
+	std::lock_guard write_lock{ mWriteMutex };
+
+	std::vector<std::pair<std::string, std::vector<byte>>> taken;
+	{
+		std::lock_guard lock{ mMutex };
+		for (auto pending{ std::begin(mBuffers) }; pending != std::end(mBuffers);) {
+			if (pending->second.bytes.empty() || !predicate(pending->first, pending->second)) {
+				++pending;
+				continue;
+			}
+			mStats.pending_bytes -= pending->second.bytes.size();
+			taken.emplace_back(pending->first, std::move(pending->second.bytes));
+			pending = mBuffers.erase(pending);
+		}
+	}
+
+	bool written{ true };
+	for (const auto &[path, bytes] : taken) {
+		written &= write(path, bytes);
+	}
+	return written;
+}
+
+bool write_behind::write(const fs::path &path, const std::vector<byte> &bytes) {
+	if (fs::ofstream file{ path, std::ios::binary | std::ios::app }; file.is_open()) {
+		file.write(reinterpret_cast<const char *>(bytes.data()), bytes.size());
+		if (file) [[likely]] {
+			std::lock_guard lock{ mMutex };
+			++mStats.writes;
+			mStats.bytes_written += bytes.size();
+			return true;
+		}
+	}
+	spdlog::error("[{}]: Cannot append {} bytes to '{}'", class_name, bytes.size(), path.string());
+	return false;
+}
+
+} // namespace golxzn::core::resources
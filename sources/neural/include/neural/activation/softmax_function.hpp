@@ -0,0 +1,49 @@
+#pragma once
+
+#include "neural/activation/function.hpp"
+#include <string_view>
+#include <optional>
+#include <span>
+
+namespace golxzn::neural::activation {
+
+/**
+ * @brief Softmax output stage fused with the cross-entropy loss.
+ * @details The softmax depends on the whole layer, so the per-neuron part is the identity and
+ * the neurons of the layer output the logits. The layer applies `forward` to get probabilities,
+ * and `cross_entropy` computes the loss and its gradient `p - y` in one pass. The log-sum-exp
+ * trick keeps both of them stable for the large logits.
+ */
+class SoftmaxFunction final : public IFunction {
+public:
+	static constexpr std::string_view class_name{ "neural::activation::SoftmaxFunction" };
+	static constexpr std::string_view type{ "softmax" };
+	SoftmaxFunction() noexcept;
+
+	core::f32 execute(core::f32 x) const noexcept override;
+	core::f32 derivative(core::f32 x) const noexcept override;
+
+	/**
+	 * @brief Write the probabilities of the logits
+	 * @param logits the raw outputs of the layer
+	 * @param probabilities the output buffer of the same size (could be the same as logits).
+	 * Nothing is written if the sizes don't match
+	 */
+	static void forward(std::span<const core::f32> logits, std::span<core::f32> probabilities) noexcept;
+
+	/**
+	 * @brief Fused softmax + cross-entropy forward and backward pass
+	 * @param logits the raw outputs of the layer
+	 * @param target the target distribution (one-hot or soft labels)
+	 * @param gradient the output buffer for the loss gradient with respect to the logits.
+	 * Could be empty if only the loss value is required, or the same as logits
+	 * @return the cross-entropy loss or std::nullopt if the sizes don't match
+	 */
+	nodis static std::optional<core::f32> cross_entropy(std::span<const core::f32> logits, std::span<const core::f32> target,
+		std::span<core::f32> gradient = {}) noexcept;
+
+private:
+	static core::f32 log_sum_exp(std::span<const core::f32> logits, const core::f32 max) noexcept;
+};
+
+} // namespace golxzn::neural::activation
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "neural/activation/function.hpp"
+#include "neural/tape.hpp"
+
+namespace golxzn::neural::activation {
+
+/**
+ * @brief The base for the custom activation functions differentiated by the tape.
+ * @details The subclass only describes the forward expression with the neural::Tape operations,
+ * both `execute` and `derivative` are derived from it. Each thread reuses its own tape, so the
+ * calls don't allocate after the first one.
+ */
+class TapeFunction : public IFunction {
+public:
+	explicit TapeFunction(const std::string &type) noexcept;
+
+	core::f32 execute(core::f32 x) const noexcept override;
+	core::f32 derivative(core::f32 x) const noexcept override;
+
+	/** @brief Record the forward expression of the function */
+	nodis virtual Tape::Variable expression(const Tape::Variable &x) const = 0;
+
+private:
+	static Tape &local_tape() noexcept;
+};
+
+} // namespace golxzn::neural::activation
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <span>
+#include <mutex>
+#include <chrono>
+#include <vector>
+#include <core/aliases.hpp>
+
+#include "neural/dataset.hpp"
+#include "neural/buffer_ring.hpp"
+#include "neural/feature_statistics.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief Gathers the next mini-batches on the helper thread while the current one is trained
+ * @details The lines of the split set are copied in their (shuffled) order into the contiguous
+ * row-major batch buffers aligned to the cache line. The buffers are allocated once and reused,
+ * so the training thread gets the ready batch without touching the scattered lines.
+ * The order of the lines is copied when gathering starts, so the dataset may be reshuffled while
+ * the helper thread runs. The new order is taken by the next `restart`.
+ *
+ * Usage:
+ *   BatchPrefetcher prefetcher{ dataset, Dataset::Type::Train };
+ *   for (core::u64 epoch{}; epoch < epochs; ++epoch) {
+ *     for (auto batch{ prefetcher.next() }; !batch.empty(); batch = prefetcher.next()) {
+ *       train(batch.inputs(), batch.outputs(), batch.size());
+ *     }
+ *     dataset.shuffle(epoch);
+ *     prefetcher.restart();
+ *   }
+ */
+class BatchPrefetcher {
+public:
+	using value_type = Dataset::value_type;
+	using clock = std::chrono::steady_clock;
+	static constexpr std::string_view class_name{ "neural::BatchPrefetcher" };
+	static constexpr size_t alignment{ 64 };
+
+	struct Settings {
+		core::u32 batch_size{ 32 };
+		core::u32 prefetch_count{ 2 }; ///< the batches gathered ahead
+		bool drop_last{ false }; ///< skip the last incomplete batch
+		core::sptr<const FeatureStatistics> statistics; ///< standardize the inputs while gathering
+	};
+
+	struct Metrics {
+		core::u64 batches{};
+		std::chrono::microseconds gather_time{};
+		std::chrono::microseconds stall_time{}; ///< the time `next` waited for the helper thread
+		core::u32 occupancy{}; ///< the ready batches right now
+		core::f64 average_occupancy{}; ///< the ready batches when `next` is called
+	};
+
+	/** @brief The gathered lines. It's valid until the next call of `next` */
+	class Batch {
+		friend class BatchPrefetcher;
+	public:
+		Batch() = default;
+
+		nodis bool empty() const noexcept { return mSize == 0; }
+		nodis core::u32 size() const noexcept { return mSize; }
+		nodis std::span<const value_type> inputs() const noexcept { return mInputs; } ///< [size][input_count]
+		nodis std::span<const value_type> outputs() const noexcept { return mOutputs; } ///< [size][output_count]
+
+	private:
+		std::span<const value_type> mInputs;
+		std::span<const value_type> mOutputs;
+		core::u32 mSize{};
+	};
+
+	/**
+	 * @brief Start gathering the lines of the split set
+	 * @details The dataset values and its split must not change until the prefetcher is destroyed.
+	 * Only the order of the lines may, see `restart`
+	 */
+	BatchPrefetcher(const Dataset &dataset, const Dataset::Type type, const Settings &settings);
+	BatchPrefetcher(const Dataset &dataset, const Dataset::Type type);
+
+	/** @brief Start gathering the lines in the given order */
+	BatchPrefetcher(const Dataset &dataset, std::span<const core::u32> lines, const Settings &settings);
+	~BatchPrefetcher();
+
+	BatchPrefetcher(const BatchPrefetcher &) = delete;
+	BatchPrefetcher &operator=(const BatchPrefetcher &) = delete;
+
+	/** @brief Take the next batch. Returns the empty batch at the end of the lines */
+	nodis Batch next();
+
+	/**
+	 * @brief Start from the first line in the current order of the lines
+	 * @details Shuffle the dataset first, then restart: the order is copied here
+	 */
+	void restart();
+
+	nodis const Settings &settings() const noexcept;
+	nodis Metrics metrics() const;
+
+private:
+	struct AlignedDeleter {
+		void operator()(value_type *values) const noexcept {
+			::operator delete[](values, std::align_val_t{ alignment });
+		}
+	};
+	using buffer_t = core::uptr<value_type[], AlignedDeleter>;
+
+	struct Buffer {
+		buffer_t inputs;
+		buffer_t outputs;
+	};
+
+	const Dataset &mDataset;
+	std::span<const core::u32> mLines;
+	std::vector<core::u32> mOrder; ///< the copy of `mLines` the helper thread reads
+	Settings mSettings;
+
+	std::vector<Buffer> mBuffers;
+	BufferRing mRing;
+
+	mutable std::mutex mMetricsMutex;
+	std::chrono::microseconds mGatherTime{};
+
+	void start();
+	void gather();
+	void gather_batch(const Buffer &buffer, std::span<const core::u32> lines) const;
+
+	static buffer_t allocate(const size_t count);
+};
+
+} // namespace golxzn::neural
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <condition_variable>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+/**
+ * @brief The bounded ring of the buffer indices between the producer thread and the consumer
+ * @details The ring doesn't own the buffers, only hands out their indices. The producer thread
+ * acquires the free buffer, fills it and publishes it. The consumer takes the published buffers
+ * in order; the taken one stays in use until the next `take`. So the producer is at most
+ * `buffers_count - 1` buffers ahead and nothing is allocated after `start`.
+ */
+class BufferRing {
+public:
+	using clock = std::chrono::steady_clock;
+	static constexpr std::string_view class_name{ "neural::BufferRing" };
+
+	struct Filled {
+		core::u32 buffer{};
+		core::u32 size{};
+	};
+
+	struct Metrics {
+		core::u64 taken{};
+		core::u64 occupancy_sum{}; ///< the sum of the ready buffers when `take` is called
+		core::u32 occupancy{}; ///< the ready buffers right now
+		std::chrono::microseconds stall_time{}; ///< the time `take` waited for the producer
+	};
+
+	BufferRing() = default;
+	~BufferRing();
+
+	BufferRing(const BufferRing &) = delete;
+	BufferRing &operator=(const BufferRing &) = delete;
+
+	/**
+	 * @brief Free all buffers and run the producer on the new thread
+	 * @details The ring is finished when the producer returns. The previous producer must be stopped
+	 */
+	void start(const core::u32 buffers_count, std::function<void()> producer);
+
+	/** @brief Wake the waiting producer and join it */
+	void stop();
+
+	/** @brief Wait for the free buffer. Returns std::nullopt when the ring is stopped */
+	nodis std::optional<core::u32> acquire();
+
+	/** @brief Pass the filled buffer to the consumer */
+	void publish(const core::u32 buffer, const core::u32 size);
+
+	/** @brief Return the acquired buffer unfilled */
+	void release(const core::u32 buffer);
+
+	/**
+	 * @brief Free the previously taken buffer and take the next one. Blocks until the producer has it
+	 * @return std::nullopt when the producer has finished and all buffers were taken
+	 */
+	nodis std::optional<Filled> take();
+
+	nodis Metrics metrics() const;
+
+private:
+	std::vector<core::u32> mFree;
+	std::deque<Filled> mFilled;
+	std::optional<core::u32> mCurrent;
+
+	mutable std::mutex mMutex;
+	std::condition_variable mCondition;
+	std::thread mProducer;
+	bool mRunning{ false };
+	bool mFinished{ true }; ///< the ring that was never started has nothing to take
+
+	Metrics mMetrics{};
+};
+
+} // namespace golxzn::neural
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <functional>
+#include <string_view>
+#include <core/aliases.hpp>
+
+#include "neural/dataset.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief The dataset file made of the independently zlib-compressed blocks of lines
+ * @details The file is formatted in the following manner:
+ * [header][index][block 0][block 1]...
+ *  - header: [magic "GTDZ"][version][input_count][output_count][lines_per_block][blocks_count] as
+ *    core::u32 and [lines_count] as core::u64;
+ *  - index: [offset (core::u64)][compressed_size (core::u32)][lines_count (core::u32)] per block,
+ *    the offset is from the beginning of the file;
+ *  - block: the zlib stream of the row-major lines, the same as in the raw dataset file.
+ * Any block is decompressed without touching the others, so the blocks are decompressed in
+ * parallel and each block is reachable directly through the index.
+ */
+class CompressedDataset {
+public:
+	using value_type = Dataset::value_type;
+	using block_callback = std::function<void(const core::u32 block, std::span<const value_type> lines)>;
+
+	static constexpr std::string_view class_name{ "neural::CompressedDataset" };
+	static constexpr core::u32 magic{ 0x5A445447 }; // "GTDZ"
+	static constexpr core::u32 version{ 1 };
+
+	struct Settings {
+		core::u32 lines_per_block{ 8192 };
+		core::i32 level{ 6 }; ///< zlib level from 1 (fastest) to 9 (smallest)
+		core::u32 threads_count{ 0 }; ///< 0 means std::thread::hardware_concurrency
+	};
+
+	nodis static std::vector<core::byte> compress(const Dataset &dataset, const Settings &settings);
+	nodis static std::vector<core::byte> compress(const Dataset &dataset);
+
+	/** @brief Compress and save through core::resources::manager */
+	static bool save(const Dataset &dataset, const std::string_view path, const Settings &settings);
+
+	CompressedDataset() = default;
+
+	/** @brief Map the `res://` or `user://` file. The other URLs are loaded by the manager */
+	explicit CompressedDataset(const std::string_view file);
+	explicit CompressedDataset(std::vector<core::byte> &&content);
+
+	nodis bool is_open() const noexcept;
+	nodis core::u32 get_input_count() const noexcept;
+	nodis core::u32 get_output_count() const noexcept;
+	nodis core::u64 lines_count() const noexcept;
+	nodis core::u32 blocks_count() const noexcept;
+	nodis core::u32 block_lines_count(const core::u32 block) const noexcept;
+	nodis size_t compressed_size() const noexcept;
+
+	/**
+	 * @brief Decompress the single block
+	 * @param lines the buffer. It's resized to the block size
+	 */
+	bool read_block(const core::u32 block, std::vector<value_type> &lines) const;
+
+	/**
+	 * @brief Decompress the blocks in order on `threads_count` threads
+	 * @details The next window of blocks is being decompressed while the callback gets the current one
+	 */
+	bool stream(const block_callback &callback, const core::u32 threads_count = 0) const;
+
+	/** @brief Decompress the whole dataset in parallel */
+	nodis Dataset load(const core::u32 threads_count = 0) const;
+
+private:
+	struct Block {
+		core::u64 offset{};
+		core::u32 compressed_size{};
+		core::u32 lines_count{};
+	};
+
+	core::resources::resource_view mMapping;
+	std::vector<core::byte> mContent;
+	std::span<const core::byte> mBytes;
+
+	core::u32 mInputCount{};
+	core::u32 mOutputCount{};
+	core::u64 mLinesCount{};
+	std::vector<Block> mBlocks;
+	std::vector<core::u64> mFirstLines; ///< the index of the first line of each block
+
+	void parse();
+	bool decompress(const core::u32 block, std::span<value_type> lines) const;
+
+	static core::u32 threads_or_default(const core::u32 threads_count) noexcept;
+};
+
+} // namespace golxzn::neural
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <span>
 #include <vector>
 #include <array>
 #include <core/aliases.hpp>
+#include <core/resources/resource_view.hpp>
 
 namespace golxzn::neural {
 
+class FeatureStatistics;
+
 /**
  * @brief The dataset class
  * @details The dataset class using for train and test neural network
@@ -14,18 +18,28 @@ namespace golxzn::neural {
  * or
  * [input_count][output_count][data...], where [input_count] and [output_count] are core::u32 (4 bytes),
  * so the offset will be 8 bytes.
+ * or
+ * the self-describing neural::DatasetFormat file, which is detected by its magic.
+ *
+ * All values live in the single contiguous buffer. With Layout::RowMajor the buffer repeats the
+ * file layout, so the loading is the single copy and every line is a span over the buffer.
+ * With Layout::ColumnMajor each column (input or output value) is contiguous instead, which is
+ * better for the per-feature passes.
+ * Dataset::map doesn't copy anything: the lines are the views over the mapped file. Such
+ * dataset is read-only until it's modified, which copies the mapped data into the buffer first.
  *
  * Terminology:
  *  - line: the data with the `input_count` count of intput data and `output_count` count of output data:
  *    [input 1][input 2][input 3]...[input `input_count`][output 1][output 2]...[output `output_count`]
+ *  - column: the values of the same input or output of all lines. The outputs columns follow the inputs
  *  - offset: the offset from the start of the line to the beginning of the data
  */
 class Dataset {
 public:
-	template<class T> using data_t = std::vector<std::vector<T>>;
-	template<class T> using data_ref_t = std::vector<std::reference_wrapper<const std::vector<T>>>;
 	using count_value_type = core::u32;
 	using value_type = core::f32;
+	using line_t = std::span<const value_type>;
+	using lines_t = std::vector<core::u32>;
 	static constexpr auto value_size{ sizeof(value_type) };
 	static constexpr auto count_value_size{ sizeof(count_value_type) };
 	static constexpr std::string_view class_name{ "neural::Dataset" };
@@ -35,11 +49,25 @@ public:
 		Test
 	};
 
+	enum class Layout : core::u8 {
+		RowMajor,
+		ColumnMajor
+	};
+
+	class View;
+
 	Dataset() = default;
+	explicit Dataset(const Layout layout);
+
+	Dataset(const std::vector<core::byte> &raw_data, const core::u32 input_count, const core::u32 output_count = 1,
+		const Layout layout = Layout::RowMajor);
 
-	Dataset(const std::vector<core::byte> &raw_data, const core::u32 input_count, const core::u32 output_count = 1);
+	Dataset(const std::string_view file, const core::u32 input_count, const core::u32 output_count = 1,
+		const Layout layout = Layout::RowMajor);
 
-	Dataset(const std::string_view file, const core::u32 input_count, const core::u32 output_count = 1);
+	/** @brief Take the row-major lines without copying */
+	Dataset(std::vector<value_type> &&data, const core::u32 input_count, const core::u32 output_count,
+		const Layout layout = Layout::RowMajor);
 
 	/**
 	 * @brief Construct a new Dataset object using file with stored input and output count data
@@ -47,16 +75,60 @@ public:
 	 * [input_count][output_count][data...], where [input_count] and [output_count] are
 	 * core::u32 (4 bytes)), so the offset will be 8 bytes
 	 */
-	explicit Dataset(const std::string_view file);
+	explicit Dataset(const std::string_view file, const Layout layout = Layout::RowMajor);
+
+	/**
+	 * @brief Map the headerless file without copying. The layout is always Layout::RowMajor
+	 * @param file the `res://` or `user://` file. The other URLs are loaded by the manager
+	 */
+	nodis static Dataset map(const std::string_view file, const core::u32 input_count, const core::u32 output_count = 1);
+
+	/**
+	 * @brief Map the file with the [input_count][output_count] header without copying
+	 * @details The neural::DatasetFormat file is mapped only if it stores the plain f64 values,
+	 * otherwise it's decoded into the buffer
+	 */
+	nodis static Dataset map(const std::string_view file);
 
 	/**
 	 * @brief Split the loaded data to the train and test sets
+	 * @details The split is the single permutation of the line indices: the train lines are
+	 * followed by the test lines. The data itself is never copied or moved.
 	 * @param ratio the percentage of data to be stored in the train set
+	 * @param seed the same seed gives the same split
 	 */
 	void split(const core::f32 ratio);
+	void split(const core::f32 ratio, const core::u64 seed);
 
-	nodis const data_ref_t<value_type> &get_input(const Type type) const noexcept;
-	nodis const data_ref_t<value_type> &get_output(const Type type) const noexcept;
+	/**
+	 * @brief Split keeping the share of each output class in both sets
+	 * @details The class of the line is the index of the greatest output, or the output value
+	 * itself if there's the only output. The train count of each class is its share rounded by
+	 * the largest remainders, so the train set has `ratio` of all lines as the plain split does.
+	 * The single non-integer output isn't a class, so such a dataset is split randomly
+	 */
+	void split_stratified(const core::f32 ratio, const core::u64 seed);
+
+	/**
+	 * @brief K-fold split
+	 * @details The lines are shuffled with the seed and cut to `folds` equal parts. The part
+	 * `fold` is the test set and the rest is the train set, so iterating `fold` from 0 to `folds`
+	 * with the same seed visits every line as the test one exactly once.
+	 */
+	void split_fold(const core::u32 folds, const core::u32 fold, const core::u64 seed);
+
+	/** @brief Reorder the train set for the next epoch. Doesn't allocate */
+	void shuffle(const core::u64 seed);
+
+	/**
+	 * @brief The indices of the lines of the split set
+	 * @details Appending keeps the split: the new lines just aren't in any set until the next
+	 * split. Erasing makes the split stale, so it's empty until the next split
+	 */
+	nodis std::span<const core::u32> get_lines(const Type type) const noexcept;
+
+	/** @brief The zero-copy view of the split set. It's valid until the dataset is modified */
+	nodis View view(const Type type) const noexcept;
 
 	/**
 	 * @brief Append line
@@ -67,21 +139,60 @@ public:
 		const std::initializer_list<value_type> &output_data) noexcept;
 
 	/**
-	 * @brief Append line
-	 * @param input_data input data part of line
-	 * @param output_data output data part of line
+	 * @brief Append lines in bulk
+	 * @details The buffer grows geometrically, so appending is amortized O(1) per line in
+	 * Layout::RowMajor. Layout::ColumnMajor moves every column once per call, so append the
+	 * bigger batches there.
+	 * @param inputs the row-major [count][input_count] values
+	 * @param outputs the row-major [count][output_count] values
 	 */
-	Dataset &append(std::initializer_list<value_type> &&input_data,
-		std::initializer_list<value_type> &&output_data) noexcept;
+	Dataset &append_rows(std::span<const value_type> inputs, std::span<const value_type> outputs,
+		const core::u32 count) noexcept;
 
+	/** @brief Erase the line keeping the order of the rest. O(n) */
 	void erase(const core::u32 line);
 
+	/**
+	 * @brief Erase the line moving the last line in its place. O(1) in Layout::RowMajor
+	 * @details The memory is given back once less than a quarter of the buffer capacity is used
+	 */
+	void swap_erase(const core::u32 line);
+
+	/** @brief Standardize the input columns in place with the precomputed statistics */
+	void standardize(const FeatureStatistics &statistics);
+
+	/** @brief Rearrange the buffer to the layout. O(n) if the layout differs */
+	void set_layout(const Layout layout);
+	nodis Layout layout() const noexcept;
+
 	nodis std::vector<core::byte> raw() const;
 	nodis core::u32 get_input_count() const noexcept;
 	nodis core::u32 get_output_count() const noexcept;
+	nodis core::u32 line_size() const noexcept;
+	nodis core::u32 lines_count() const noexcept;
+	nodis bool empty() const noexcept;
+	nodis bool is_mapped() const noexcept;
+
+	/** @brief The whole buffer in the current layout */
+	nodis std::span<const value_type> data() const noexcept;
 
-	nodis const data_t<value_type> &get_raw_input() const noexcept;
-	nodis const data_t<value_type> &get_raw_output() const noexcept;
+	/** @brief The line view. Available for Layout::RowMajor only, otherwise it's empty */
+	nodis line_t line(const core::u32 line) const noexcept;
+	nodis line_t input(const core::u32 line) const noexcept;
+	nodis line_t output(const core::u32 line) const noexcept;
+
+	/** @brief The column view. Available for Layout::ColumnMajor only, otherwise it's empty */
+	nodis std::span<const value_type> column(const core::u32 column) const noexcept;
+
+	/** @brief The single value in any layout */
+	nodis value_type at(const core::u32 line, const core::u32 column) const noexcept;
+
+	/**
+	 * @brief Copy the line into the buffers in any layout
+	 * @param input_data the buffer of `get_input_count()` size at least
+	 * @param output_data the buffer of `get_output_count()` size at least
+	 */
+	bool read_line(const core::u32 line, std::span<value_type> input_data, std::span<value_type> output_data) const noexcept;
 
 	void clean();
 	void clean_split();
@@ -92,56 +203,64 @@ public:
 #endif
 
 private:
+	Layout mLayout{ Layout::RowMajor };
 	core::u32 mLinesCount{};
-	data_t<value_type> mInputData;
-	data_t<value_type> mOutputData;
+	core::u32 mInputCount{};
+	core::u32 mOutputCount{};
+	std::vector<value_type> mData;
+	core::resources::resource_view mMapping;
+	std::span<const value_type> mMapped;
 
-	data_ref_t<value_type> mTrainDataInput;
-	data_ref_t<value_type> mTrainDataOutput;
+	lines_t mOrder; ///< the train lines followed by the test lines
+	core::u32 mTrainCount{};
+	bool mSplitStale{ false };
 
-	data_ref_t<value_type> mTestDataInput;
-	data_ref_t<value_type> mTestDataOutput;
+	void map_from(core::resources::resource_view mapping, const size_t offset,
+		const core::u32 input_count, const core::u32 output_count);
 
-	void load_from_raw_data(const core::byte *raw_data, const core::u32 data_length,
+	/** @brief Copy the mapped data into the own buffer before the modification */
+	void detach();
+
+	void reset_order();
+	/** @return std::nullopt if the single output isn't an integer class label */
+	nodis std::optional<core::u64> class_of(const core::u32 line) const noexcept;
+
+	void load_from_raw_data(const core::byte *raw_data, const size_t data_length,
 		const core::u32 input_count, const core::u32 output_count);
 
-	bool validate(const std::initializer_list<value_type> &input_data,
-		const std::initializer_list<value_type> &output_data) const noexcept;
+	bool validate(const core::u32 input_count, const core::u32 output_count) const noexcept;
 
-	static bool is_input_id(const core::u32 id, const core::u32 line_size,
-		const core::u32 input_count) noexcept;
+	static void transpose(std::span<const value_type> from, std::span<value_type> to,
+		const size_t rows, const size_t columns) noexcept;
 
 	static std::array<count_value_type, 3>  get_input_and_output_count(const std::vector<core::byte> &data);
 };
 
-} // namespace golxzn::neural
+/** @brief The lines of the dataset in the order of the split set */
+class Dataset::View {
+public:
+	View() = default;
+	View(const Dataset &dataset, std::span<const core::u32> lines) noexcept
+		: mDataset{ &dataset }, mLines{ lines } {}
+
+	nodis bool empty() const noexcept { return mLines.empty(); }
+	nodis core::u32 lines_count() const noexcept { return static_cast<core::u32>(mLines.size()); }
+	nodis std::span<const core::u32> lines() const noexcept { return mLines; }
+
+	/** @brief The index of the line in the dataset */
+	nodis core::u32 index(const core::u32 line) const noexcept { return mLines[line]; }
 
-/*
-
-		if (raw_data.empty()) [[unlikely]] return;
-
-		const auto data_count{ raw_data.size() / value_size };
-		const auto line_size{ input_count + output_count };
-		mLinesCount = data_count / line_size;
-
-		mInputData.resize(mLinesCount * input_count);
-		mOutputData.resize(mLinesCount * output_count);
-
-		const auto value{ reinterpret_cast<const value_type *>(raw_data.data()) };
-		for(uint32_t id{}; id < data_count; ++id) {
-			if ((id % line_size) < input_count) {
-				// std::cout << "when id = " << id  << "\t";
-				auto &input = mInputData.at(id / input_count / line_size);
-				if (input.capacity() == 0) {
-					input.reserve(input_count);
-				}
-				input.emplace_back(value[id]);
-			} else {
-				auto &output = mOutputData.at(id / output_count / line_size);
-				if (output.capacity() == 0) {
-					output.reserve(output_count);
-				}
-				output.emplace_back(value[id]);
-			}
-		}
-*/
+	nodis line_t line(const core::u32 line) const noexcept { return mDataset->line(mLines[line]); }
+	nodis line_t input(const core::u32 line) const noexcept { return mDataset->input(mLines[line]); }
+	nodis line_t output(const core::u32 line) const noexcept { return mDataset->output(mLines[line]); }
+
+	bool read_line(const core::u32 line, std::span<value_type> input_data, std::span<value_type> output_data) const noexcept {
+		return mDataset->read_line(mLines[line], input_data, output_data);
+	}
+
+private:
+	const Dataset *mDataset{ nullptr };
+	std::span<const core::u32> mLines;
+};
+
+} // namespace golxzn::neural
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+/**
+ * @brief Converts the text table (CSV) to the neural::Dataset binary format
+ * @details The text is cut into one chunk per thread at the line boundaries and every chunk is
+ * parsed with `std::from_chars` in parallel. The chunks are concatenated in the original order.
+ * The last `output_count` columns of each line are the outputs, the rest are the inputs.
+ */
+class DatasetConverter {
+public:
+	static constexpr std::string_view class_name{ "neural::DatasetConverter" };
+
+	struct Settings {
+		char separator{ ',' };
+		core::u32 output_count{ 1 };
+		core::u32 threads_count{ 0 }; ///< 0 means std::thread::hardware_concurrency
+		bool skip_first_line{ false }; ///< the first line is the column names
+		bool write_counts{ true }; ///< write the [input_count][output_count] header
+	};
+
+	GOLXZN_STATIC_CLASS(DatasetConverter);
+
+	/**
+	 * @brief Parse the text into the dataset file content
+	 * @return the empty vector if the text is empty or malformed
+	 */
+	nodis static std::vector<core::byte> convert(const std::string_view text, const Settings &settings);
+	nodis static std::vector<core::byte> convert(const std::string_view text);
+
+	/** @brief Convert the text file to the binary one. The source is memory mapped */
+	static bool convert(const core::fs::path &source, const core::fs::path &output, const Settings &settings);
+
+	/** @brief ',' for the .csv files and ' ' for the rest */
+	nodis static char separator_of(const core::fs::path &source) noexcept;
+
+private:
+	struct Chunk {
+		std::vector<core::f32> values;
+		size_t lines_count{}; ///< the lines with values
+		size_t physical_lines{}; ///< all lines of the chunk including the blank ones
+		size_t columns_count{};
+		size_t error_line{}; ///< the 1-based physical line in the chunk where the parsing failed
+	};
+
+	static std::vector<std::string_view> cut(const std::string_view text, const size_t count);
+	static Chunk parse(const std::string_view text, const char separator);
+};
+
+} // namespace golxzn::neural
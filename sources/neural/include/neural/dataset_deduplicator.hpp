@@ -0,0 +1,48 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+class Dataset;
+
+/**
+ * @brief Finds the exact duplicate lines of the dataset
+ * @details Each thread hashes its range of lines with core::utils::hash. Then the lines are
+ * counting-sorted into the shards by their hashes, so every thread walks only its own shard and
+ * inserts the lines into its own open-addressing table without any lock. The lines with the same
+ * hash are compared byte by byte, so the collisions never merge the different lines.
+ * Note that the lines are compared by their bytes: 0.0 and -0.0 are different lines, and the
+ * same NaN values are the same lines.
+ */
+class DatasetDeduplicator {
+public:
+	GOLXZN_STATIC_CLASS(DatasetDeduplicator);
+
+	static constexpr std::string_view class_name{ "neural::DatasetDeduplicator" };
+
+	struct Result {
+		std::vector<core::u32> unique; ///< the first occurrence of each line in ascending order
+		std::vector<core::u32> multiplicities; ///< how many times each unique line occurs
+
+		nodis core::u32 duplicates_count() const noexcept;
+
+		/** @brief The multiplicities as the sample weights of the unique lines */
+		nodis std::vector<core::f32> weights() const;
+	};
+
+	/** @brief Find the unique lines without modifying the dataset */
+	nodis static Result find(const Dataset &dataset, const core::u32 threads_count = 0);
+
+	/**
+	 * @brief Keep only the first occurrence of each line
+	 * @details The layout is kept, but the split is cleaned if there were any duplicates
+	 * @return the result of the `find`. The unique line `i` is the line `i` of the dataset now
+	 */
+	static Result deduplicate(Dataset &dataset, const core::u32 threads_count = 0);
+};
+
+} // namespace golxzn::neural
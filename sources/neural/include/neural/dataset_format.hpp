@@ -0,0 +1,98 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <istream>
+#include <optional>
+#include <string_view>
+#include <core/aliases.hpp>
+
+#include "neural/dataset.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief The versioned self-describing dataset file
+ * @details The file is formatted in the following manner:
+ * [header][scales][offsets][padding][data...]
+ *  - header: [magic "GTDS" (u32)][version (u16)][element type (u8)][reserved (u8)][input_count (u32)]
+ *    [output_count (u32)][lines_count (u64)][alignment (u32)][data offset (u32)], 32 bytes;
+ *  - scales and offsets: one core::f32 per column each. The value is `stored * scale + offset`;
+ *  - padding: zeros up to the data offset, which is the multiple of the alignment;
+ *  - data: the row-major lines of the elements of the element type.
+ * The narrow element types shrink the file and the memory 2-8 times. They are converted back to
+ * core::f32 while loading, in the tight loops the compiler vectorizes.
+ */
+class DatasetFormat {
+public:
+	static constexpr std::string_view class_name{ "neural::DatasetFormat" };
+	static constexpr core::u32 magic{ 0x53445447 }; // "GTDS"
+	static constexpr core::u16 version{ 1 };
+	static constexpr core::u32 header_size{ 32 };
+	static constexpr core::u32 default_alignment{ 64 };
+
+	enum class ElementType : core::u8 {
+		F64,
+		F32,
+		F16,
+		BF16,
+		U8, ///< normalized: each column is quantized between its minimum and maximum
+	};
+
+	struct Header {
+		core::u16 version{ DatasetFormat::version };
+		ElementType type{ ElementType::F64 };
+		core::u32 input_count{};
+		core::u32 output_count{};
+		core::u64 lines_count{};
+		core::u32 alignment{ default_alignment };
+		core::u32 data_offset{};
+		std::vector<core::f32> scales;
+		std::vector<core::f32> offsets;
+
+		nodis core::u32 line_size() const noexcept { return input_count + output_count; }
+		nodis bool is_identity() const noexcept;
+	};
+
+	GOLXZN_STATIC_CLASS(DatasetFormat);
+
+	nodis static size_t element_size(const ElementType type) noexcept;
+
+	/** @brief Check the magic only */
+	nodis static bool is_formatted(std::span<const core::byte> content) noexcept;
+
+	/** @brief Parse and validate the header against the content size */
+	nodis static std::optional<Header> read_header(std::span<const core::byte> content);
+
+	/**
+	 * @brief Parse and validate the header at the beginning of the content of `content_size` bytes
+	 * @param head the header and the tables at least, e.g. the head of the streamed file
+	 */
+	nodis static std::optional<Header> read_header(std::span<const core::byte> head, const core::u64 content_size);
+
+	/**
+	 * @brief Read the header and the tables from the current position of the stream
+	 * @details Nothing but them is read, so the data could be streamed by chunks afterwards
+	 */
+	nodis static std::optional<Header> read_header(std::istream &stream, const core::u64 content_size);
+
+	nodis static std::vector<core::byte> encode(const Dataset &dataset, const ElementType type,
+		const core::u32 alignment = default_alignment);
+
+	/** @brief Convert the elements to core::f32 */
+	nodis static Dataset decode(std::span<const core::byte> content, const Dataset::Layout layout = Dataset::Layout::RowMajor);
+
+	static bool save(const Dataset &dataset, const std::string_view path, const ElementType type);
+
+	/**
+	 * @brief Convert the stored elements of the whole lines to core::f32
+	 * @param from at least `to.size()` elements of `header.type`
+	 * @param to the whole lines, so the columns start from the first element
+	 */
+	static void decode_values(std::span<const core::byte> from, std::span<core::f32> to, const Header &header);
+
+private:
+	static void encode_values(std::span<const core::f32> from, std::span<core::byte> to, const Header &header);
+};
+
+} // namespace golxzn::neural
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <span>
+#include <mutex>
+#include <chrono>
+#include <optional>
+#include <vector>
+#include <core/aliases.hpp>
+
+#include "neural/dataset.hpp"
+#include "neural/buffer_ring.hpp"
+#include "neural/dataset_format.hpp"
+#include "neural/feature_statistics.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief Reads the dataset file chunk by chunk on the background thread
+ * @details The file has the same format as for neural::Dataset or the neural::DatasetFormat one,
+ * whose elements are converted to core::f32 while reading. The reader thread fills up to
+ * `buffers_count` chunks ahead, so the disk reads overlap with the training on the current
+ * chunk. Only `buffers_count` chunks are in the memory at once, whatever the file size is.
+ *
+ * Usage:
+ *   DatasetStream stream{ "user://huge.bin" };
+ *   for (auto chunk{ stream.next() }; !chunk.empty(); chunk = stream.next()) {
+ *     for (core::u32 line{}; line < chunk.lines_count(); ++line) train(chunk.input(line), chunk.output(line));
+ *   }
+ */
+class DatasetStream {
+public:
+	using value_type = Dataset::value_type;
+	using clock = std::chrono::steady_clock;
+	static constexpr std::string_view class_name{ "neural::DatasetStream" };
+
+	struct Settings {
+		core::u32 chunk_lines{ 4096 };
+		core::u32 buffers_count{ 3 }; ///< 2 for double buffering, 3 for triple buffering
+		core::sptr<const FeatureStatistics> statistics; ///< standardize the inputs while reading
+	};
+
+	struct Metrics {
+		core::u64 bytes_read{};
+		core::u64 chunks{};
+		core::f64 bytes_per_second{}; ///< the disk throughput while reading
+		std::chrono::microseconds read_time{};
+		std::chrono::microseconds stall_time{}; ///< the time `next` waited for the reader
+	};
+
+	/** @brief The lines of the single read. It's valid until the next call of `next` */
+	class Chunk {
+		friend class DatasetStream;
+	public:
+		Chunk() = default;
+
+		nodis bool empty() const noexcept { return mLinesCount == 0; }
+		nodis core::u32 lines_count() const noexcept { return mLinesCount; }
+		nodis std::span<const value_type> data() const noexcept { return mData; }
+
+		nodis Dataset::line_t line(const core::u32 line) const noexcept {
+			return mData.subspan(static_cast<size_t>(line) * (mInputCount + mOutputCount), mInputCount + mOutputCount);
+		}
+		nodis Dataset::line_t input(const core::u32 line) const noexcept { return this->line(line).first(mInputCount); }
+		nodis Dataset::line_t output(const core::u32 line) const noexcept { return this->line(line).subspan(mInputCount); }
+
+	private:
+		std::span<const value_type> mData;
+		core::u32 mLinesCount{};
+		core::u32 mInputCount{};
+		core::u32 mOutputCount{};
+	};
+
+	/** @brief Stream the file with the [input_count][output_count] or the DatasetFormat header */
+	explicit DatasetStream(const std::string_view file);
+	DatasetStream(const std::string_view file, const Settings &settings);
+
+	/** @brief Stream the headerless file */
+	DatasetStream(const std::string_view file, const core::u32 input_count, const core::u32 output_count,
+		const Settings &settings);
+	~DatasetStream();
+
+	DatasetStream(const DatasetStream &) = delete;
+	DatasetStream &operator=(const DatasetStream &) = delete;
+
+	/**
+	 * @brief Take the next chunk. Blocks until the reader has it
+	 * @return the empty chunk when the whole file was read
+	 */
+	nodis Chunk next();
+
+	/** @brief Start reading from the beginning of the file, e.g. for the next epoch */
+	void restart();
+
+	nodis bool is_open() const noexcept;
+	nodis core::u32 get_input_count() const noexcept;
+	nodis core::u32 get_output_count() const noexcept;
+	nodis const Settings &settings() const noexcept;
+	nodis Metrics metrics() const;
+
+private:
+	Settings mSettings;
+	core::fs::path mPath;
+	size_t mOffset{};
+	size_t mEnd{};
+	std::optional<DatasetFormat::Header> mFormat;
+	std::vector<core::byte> mStaging; ///< the stored elements of the formatted file before decoding
+	core::u32 mInputCount{};
+	core::u32 mOutputCount{};
+
+	std::vector<std::vector<value_type>> mBuffers;
+	BufferRing mRing;
+
+	mutable std::mutex mMetricsMutex;
+	Metrics mMetrics{};
+
+	void open(const std::string_view file, const bool has_header);
+	void read();
+};
+
+} // namespace golxzn::neural
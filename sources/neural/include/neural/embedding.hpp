@@ -0,0 +1,97 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+#include "neural/constants.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief The sparse input layer
+ * @details Holds the `vocabulary_size` x `dimension` weight table in a single row-major buffer.
+ * The input is a list of (index, value) pairs, so only the rows of the used indices are read
+ * during the lookup and written during the update. The cost of one message depends on the
+ * count of its features instead of the vocabulary size.
+ *
+ * Terminology:
+ *  - feature: the pair of the row index and its value (e.g. the hashed token and its count)
+ *  - row: the `dimension` weights of the one vocabulary index
+ */
+class Embedding {
+public:
+	using index_type = core::u32;
+	using value_type = core::f32;
+
+	struct Feature {
+		index_type index{};
+		value_type value{};
+	};
+	using input_t = std::vector<Feature>;
+
+	static constexpr std::string_view class_name{ "neural::Embedding" };
+	static constexpr std::string_view token_separators{ " \t\n\r" };
+
+	Embedding() = default;
+	Embedding(const core::u32 vocabulary_size, const core::u32 dimension);
+
+	nodis core::u32 vocabulary_size() const noexcept;
+	nodis core::u32 dimension() const noexcept;
+
+	nodis std::span<const value_type> row(const index_type index) const noexcept;
+	nodis std::span<value_type> row(const index_type index) noexcept;
+
+	/**
+	 * @brief Gather-sum lookup
+	 * @param input the sparse features
+	 * @return the dense vector of `dimension` size: sum of `row(index) * value` for each feature
+	 */
+	nodis std::vector<value_type> lookup(const input_t &input) const;
+
+	/**
+	 * @brief Gather-sum lookup into the existing buffer
+	 * @param input the sparse features
+	 * @param output the buffer of `dimension` size. It will be overwritten
+	 */
+	void lookup(const input_t &input, std::span<value_type> output) const noexcept;
+
+	/**
+	 * @brief Sparse gradient descent step. Only the rows of the input features are touched
+	 * @param input the sparse features used for the lookup
+	 * @param gradient the loss gradient with respect to the lookup output (`dimension` size)
+	 * @param rate the learning rate
+	 */
+	void update(const input_t &input, std::span<const value_type> gradient,
+		const core::f32 rate = constants::learning_rate) noexcept;
+
+	void randomize(const core::f32 min, const core::f32 max);
+	void randomize(const core::f32 range = constants::random_max_weight);
+
+	/**
+	 * @brief Hash the token into the vocabulary index
+	 * @details The hash is fixed, so the index doesn't depend on the platform or the toolchain
+	 * @param token the text token
+	 * @return the index in [0, `vocabulary_size`)
+	 */
+	nodis index_type index_of(const std::string_view token) const noexcept;
+
+	/**
+	 * @brief Make the hashed bag-of-words features from the text
+	 * @details The text is split by `token_separators`. The repeated tokens (and the tokens with
+	 * colliding hashes) are merged into the one feature with the accumulated count. The features
+	 * are sorted by the index.
+	 * @param text the text to be hashed
+	 */
+	nodis input_t make_input(const std::string_view text) const;
+
+private:
+	core::u32 mVocabularySize{};
+	core::u32 mDimension{};
+	std::vector<value_type> mWeights;
+
+	nodis bool is_valid(const Feature &feature) const noexcept;
+};
+
+} // namespace golxzn::neural
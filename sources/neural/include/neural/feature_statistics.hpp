@@ -0,0 +1,84 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+class Dataset;
+
+/**
+ * @brief Per-column mean, variance, minimum and maximum of the dataset
+ * @details Computed in the single pass: each thread runs Welford's update over its range of
+ * lines and the partial results are merged with Chan's formula, which is as stable as the
+ * sequential pass. The statistics are saved next to the dataset, so the inference applies
+ * exactly the same standardization as the training.
+ */
+class FeatureStatistics {
+public:
+	using value_type = core::f32;
+	static constexpr std::string_view class_name{ "neural::FeatureStatistics" };
+	static constexpr core::u32 magic{ 0x53465447 }; // "GTFS"
+	static constexpr core::u32 version{ 1 };
+
+	struct Column {
+		core::u64 count{};
+		value_type mean{};
+		value_type m2{}; ///< the sum of the squared differences from the mean
+		value_type min{ (std::numeric_limits<value_type>::max)() };
+		value_type max{ std::numeric_limits<value_type>::lowest() };
+
+		void update(const value_type value) noexcept;
+		void merge(const Column &other) noexcept;
+
+		nodis value_type variance() const noexcept;
+		nodis value_type deviation() const noexcept;
+	};
+
+	FeatureStatistics() = default;
+	FeatureStatistics(const core::u32 input_count, const core::u32 output_count);
+
+	/** @brief Compute the statistics of all columns in parallel */
+	nodis static FeatureStatistics compute(const Dataset &dataset, const core::u32 threads_count = 0);
+
+	/** @brief Add the row-major lines, e.g. the chunk of neural::DatasetStream */
+	void update(std::span<const value_type> lines);
+	void merge(const FeatureStatistics &other);
+
+	nodis bool empty() const noexcept;
+	nodis core::u32 get_input_count() const noexcept;
+	nodis core::u32 get_output_count() const noexcept;
+	nodis const std::vector<Column> &columns() const noexcept;
+
+	/** @brief 1 / deviation of the column, or 1 for the constant column. It's cached, not recomputed */
+	nodis value_type inverse_deviation(const core::u32 column) const noexcept;
+
+	/**
+	 * @brief (x - mean) * inverse deviation in place
+	 * @param values the consecutive columns starting from `first_column`
+	 */
+	void standardize(std::span<value_type> values, const core::u32 first_column = 0) const noexcept;
+
+	/** @brief Standardize the inputs of the line, e.g. before the inference */
+	void standardize_input(std::span<value_type> input) const noexcept;
+
+	nodis std::vector<core::byte> serialize() const;
+	nodis static FeatureStatistics deserialize(std::span<const core::byte> content);
+
+	bool save(const std::string_view path) const;
+	nodis static FeatureStatistics load(const std::string_view path);
+
+private:
+	core::u32 mInputCount{};
+	core::u32 mOutputCount{};
+	std::vector<Column> mColumns;
+	std::vector<value_type> mMeans;
+	std::vector<value_type> mInverseDeviations;
+
+	/** @brief Cache the means and the inverse deviations after the columns were changed */
+	void refresh();
+};
+
+} // namespace golxzn::neural
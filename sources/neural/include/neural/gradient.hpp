@@ -0,0 +1,64 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+class Network;
+
+/**
+ * @brief The flat buffer of the back propagation shifts
+ * @details All shifts of the network live in the single contiguous buffer. The layout mirrors
+ * the order in which the weights are shifted back: layer by layer, neuron by neuron, and the
+ * previous edges of each neuron. The buffer is allocated once and reused between passes.
+ */
+class Gradient {
+	template<class T> using three_vec_t = std::vector<std::vector<std::vector<T>>>;
+public:
+	using value_type = core::f32;
+
+	Gradient() = default;
+	explicit Gradient(const Network &network);
+
+	/** @brief Rebuild the layout for the network. Does nothing if the layout is the same */
+	void reshape(const Network &network);
+	void fill(const value_type value = value_type{}) noexcept;
+
+	nodis bool empty() const noexcept;
+	nodis size_t size() const noexcept;
+	nodis core::u32 layers_count() const noexcept;
+	nodis core::u32 neurons_count(const core::u32 layer) const noexcept;
+
+	nodis std::span<value_type> values() noexcept;
+	nodis std::span<const value_type> values() const noexcept;
+
+	nodis std::span<value_type> layer(const core::u32 layer) noexcept;
+	nodis std::span<const value_type> layer(const core::u32 layer) const noexcept;
+
+	/**
+	 * @brief The loss gradient with respect to the output layer values
+	 * @details The scratch buffer of the last layer's neurons count. The fused softmax stage
+	 * writes the logits and their gradient here instead of the temporary vectors
+	 */
+	nodis std::span<value_type> output() noexcept;
+	nodis std::span<const value_type> output() const noexcept;
+
+	nodis std::span<value_type> neuron(const core::u32 layer, const core::u32 neuron) noexcept;
+	nodis std::span<const value_type> neuron(const core::u32 layer, const core::u32 neuron) const noexcept;
+
+	/** @brief Compatibility adapter for the nested vectors API */
+	nodis three_vec_t<value_type> to_nested() const;
+
+	/** @brief Copy the nested vectors into the buffer. The layout must be the same */
+	bool assign(const three_vec_t<value_type> &nested) noexcept;
+
+private:
+	std::vector<value_type> mValues;
+	std::vector<value_type> mOutput;
+	std::vector<size_t> mNeuronOffsets{ 0 }; ///< offsets of each neuron + the end of the buffer
+	std::vector<size_t> mLayerNeurons{ 0 }; ///< index of the first neuron of each layer + the end
+};
+
+} // namespace golxzn::neural
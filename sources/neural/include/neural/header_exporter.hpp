@@ -0,0 +1,55 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+namespace golxzn::neural {
+
+class Network;
+
+/**
+ * @brief Exports the trained network as the C++ header for neural::StaticNetwork
+ * @details The generated header contains the struct with constexpr topology, activations and
+ * the aligned flat weights, so the embedded model is placed into the read-only data and doesn't
+ * need any loading or parsing at startup:
+ * @code
+ * #include "generated/intents.hpp"
+ * const auto output{ neural::StaticNetwork::predict<neural::models::intents>({ 0.5, 1.0 }) };
+ * @endcode
+ */
+class HeaderExporter {
+public:
+	static constexpr std::string_view class_name{ "neural::HeaderExporter" };
+	static constexpr std::string_view models_namespace{ "golxzn::neural::models" };
+	static constexpr core::u32 weights_alignment{ 64 };
+
+	/** @brief The plain description of the network used to generate the header */
+	struct Model {
+		std::string name;
+		std::vector<core::u32> topology; ///< neuron counts without bias
+		std::vector<std::string> activations;
+		std::vector<core::f32> weights; ///< row-major [topology[L] + 1][topology[L + 1]] blocks
+	};
+
+	GOLXZN_STATIC_CLASS(HeaderExporter);
+
+	nodis static Model describe(const Network &network, const std::string_view name);
+
+	/** @brief Generate the header. Returns the empty string if the model is invalid */
+	nodis static std::string write(const Model &model);
+	nodis static std::string write(const Network &network, const std::string_view name);
+
+	/**
+	 * @brief Generate the header and save it through core::resources::manager
+	 * @param path the URL of the header, e.g. `user://models/intents.hpp`
+	 */
+	static bool save(const Network &network, const std::string_view name, const std::string_view path);
+
+private:
+	static bool validate(const Model &model);
+	static bool is_identifier(const std::string_view name) noexcept;
+};
+
+} // namespace golxzn::neural
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <core/aliases.hpp>
+
+#include "neural/shared_weights.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief The per-thread execution state over the shared weights
+ * @details Owns only two scratch buffers of the widest layer size, so creating one context per
+ * worker thread is cheap and all of them share the single copy of the weights. The context
+ * itself isn't thread-safe: one context must be used by one thread at a time.
+ */
+class InferenceContext {
+public:
+	static constexpr std::string_view class_name{ "neural::InferenceContext" };
+
+	explicit InferenceContext(core::sptr<const SharedWeights> weights);
+
+	nodis const core::sptr<const SharedWeights> &weights() const noexcept;
+
+	/**
+	 * @brief Run the forward pass
+	 * @param input the values of the input layer
+	 * @return the view of the output values. It's valid until the next call
+	 */
+	nodis std::span<const core::f32> predict(std::span<const core::f32> input);
+
+	nodis std::vector<core::f32> predict(const std::vector<core::f32> &input);
+
+	/**
+	 * @brief Run the forward pass for the whole batch at once
+	 * @details Each weights row is loaded once per batch instead of once per sample
+	 * @param inputs the row-major [batch_size][input_count] values
+	 * @return the view of the row-major [batch_size][output_count] values. It's valid until the next call
+	 */
+	nodis std::span<const core::f32> predict_batch(std::span<const core::f32> inputs, const core::u32 batch_size);
+
+private:
+	core::sptr<const SharedWeights> mWeights;
+	std::vector<core::f32> mCurrent;
+	std::vector<core::f32> mNext;
+
+	void activate(const core::u32 layer, std::span<core::f32> values, const size_t width) const;
+};
+
+} // namespace golxzn::neural
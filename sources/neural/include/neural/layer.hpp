@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <core/aliases.hpp>
 #include <core/types/id.hpp>
 
@@ -12,7 +13,7 @@ class Edge;
 class Neuron;
 class Network;
 
-class Layer : std::enable_shared_from_this<Layer> {
+class Layer : public std::enable_shared_from_this<Layer> {
 	template<class T> using dvec_t = std::vector<std::vector<T>>;
 public:
 	enum class Type : core::u8 {
@@ -20,6 +21,8 @@ public:
 		Hidden,
 		Output
 	};
+	static constexpr std::string_view class_name{ "neural::Layer" };
+
 	struct Settings {
 		Type type{ Type::Hidden };
 		core::u32 neuron_count{ constants::default_neuron_count };
@@ -29,9 +32,13 @@ public:
 	Layer(const core::id::type id, core::sptr<Network> network, const Settings &settings) noexcept;
 	Layer(const core::id::type id, core::sptr<Network> network, Settings &&settings) noexcept;
 
+	/** @brief Create the neurons. The layer must be owned by core::sptr already */
 	bool initialize();
 	void clean();
 
+	/** @brief Zero the accumulated values of the neurons before the next prediction */
+	void reset() noexcept;
+
 	nodis core::id::type id() const noexcept;
 	nodis Type type() const noexcept;
 	nodis core::sptr<Network> network() const noexcept;
@@ -42,13 +49,35 @@ public:
 	nodis core::sptr<activation::IFunction> activation() const noexcept;
 
 	nodis bool is(const Type type) const noexcept;
+	nodis bool is_softmax() const noexcept;
 
 	nodis dvec_t<core::f32> weights() const noexcept;
 	nodis dvec_t<core::f32> back_propagation_shifts(const std::vector<core::f32> &target_values) const noexcept;
+
+	/**
+	 * @brief Write the back propagation shifts of the layer into the flat buffer
+	 * @details The shifts of the neurons' previous edges go one after another in the neurons order
+	 * @param shifts the buffer of `gradient_size()` size
+	 * @param output_gradient the scratch buffer of `neuron_count()` size for the softmax output
+	 * layer. It receives the loss gradient with respect to the logits. Unused by other layers
+	 * @return false if the sizes don't match
+	 */
+	bool write_back_propagation_shifts(const std::vector<core::f32> &target_values,
+		std::span<core::f32> shifts, std::span<core::f32> output_gradient = {}) const;
+
+	/** @brief The count of the previous edges of all neurons in the layer */
+	nodis core::u32 gradient_size() const noexcept;
 	nodis dvec_t<core::sptr<Edge>> edges() const noexcept;
 
+	/** @brief The output values. The softmax layer returns probabilities */
 	nodis std::vector<core::f32> output() const noexcept;
 
+	/** @brief The output values without the layer-wide activation (logits for the softmax layer) */
+	nodis std::vector<core::f32> raw_output() const noexcept;
+
+	/** @brief Write the raw output into the buffer of `neuron_count()` size */
+	bool raw_output(std::span<core::f32> output) const noexcept;
+
 	void trigger();
 
 	void set_accumulate(const std::vector<core::f32> &value) noexcept;
@@ -56,7 +85,9 @@ public:
 	void connect_completely(const core::sptr<Layer> &layer);
 
 	void alter_weights(const dvec_t<core::f32> &weights);
-	void shift_back_weights(const dvec_t<core::f32> &weights);
+	/** @return false if the shifts don't match the previous edges of the neurons */
+	bool shift_back_weights(const dvec_t<core::f32> &weights);
+	bool shift_back_weights(std::span<const core::f32> shifts);
 
 	void shift_weights(const core::f32 factor);
 
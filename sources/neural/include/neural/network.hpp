@@ -2,14 +2,17 @@
 
 #include <initializer_list>
 #include <neural/layer.hpp>
+#include <neural/gradient.hpp>
 
 namespace golxzn::neural {
 
-class Network : std::enable_shared_from_this<Network> {
+class Network : public std::enable_shared_from_this<Network> {
 	template<class T> using vec_t = std::vector<T>;
 	template<class T> using double_vec_t = std::vector<std::vector<T>>;
 	template<class T> using three_vec_t = std::vector<std::vector<std::vector<T>>>;
 public:
+	static constexpr std::string_view class_name{ "neural::Network" };
+
 	Network() noexcept = default;
 	explicit Network(std::initializer_list<Layer::Settings> &&settings) noexcept;
 
@@ -26,6 +29,15 @@ public:
 	void connect_completely() noexcept;
 	void alter_weights(const three_vec_t<core::f32> &weights) noexcept;
 	void shift_back_weights(const three_vec_t<core::f32> &weights) noexcept;
+	void shift_back_weights(const Gradient &gradient);
+
+	/**
+	 * @brief Back propagation pass from the output layer to the input one
+	 * @param target_values the expected output of the last prediction
+	 * @param gradient the flat buffer for the shifts. It's reshaped if the layout doesn't match
+	 * @return false if the target size doesn't match the output layer
+	 */
+	bool back_propagation_shifts(const vec_t<core::f32> &target_values, Gradient &gradient);
 
 	three_vec_t<core::f32> weights() const noexcept;
 	three_vec_t<core::sptr<Edge>> edges() const noexcept;
@@ -40,8 +52,16 @@ public:
 	void shift_weights(const core::f32 range_percentage) noexcept;
 	vec_t<core::f32> predict(const vec_t<core::f32> &in) noexcept;
 
+	/**
+	 * @brief The loss gradient with respect to the input values (without bias)
+	 * @details Valid after the back propagation shifts of the next layers were computed.
+	 * Used to train the sparse input stage (see neural::Embedding::update)
+	 */
+	vec_t<core::f32> input_gradient() const noexcept;
+
 private:
 	vec_t<core::sptr<Layer>> mLayers{};
+	vec_t<core::f32> mOutput{}; ///< the reused buffer of the output layer values for the loss
 
 	core::f32 get_loss_coefficient() const noexcept;
 };
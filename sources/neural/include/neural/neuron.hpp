@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <core/types/id.hpp>
 #include "activation/function.hpp"
 
@@ -31,6 +32,7 @@ public:
 	nodis core::sptr<Layer> layer() const noexcept;
 	nodis std::vector<core::f32> weights() const noexcept;
 	nodis const std::vector<core::sptr<Edge>> &edges() const noexcept;
+	nodis core::u32 previous_edges_count() const noexcept;
 
 	void clean() noexcept;
 
@@ -49,9 +51,23 @@ public:
 
 	void alter_weights(const std::vector<core::f32> &values);
 	void shift_back_weights(const std::vector<core::f32> &values);
+	void shift_back_weights(std::span<const core::f32> values);
 
 	nodis std::vector<core::f32> get_back_propagation_shifts(const std::vector<core::f32> &target_values);
 
+	/**
+	 * @brief Back propagation shifts with the already computed back propagated value
+	 * @param prop_value the loss gradient with respect to the raw output of the neuron
+	 */
+	nodis std::vector<core::f32> get_back_propagation_shifts(const core::f32 prop_value);
+
+	/**
+	 * @brief Write the back propagation shifts of the previous edges without allocations
+	 * @param shifts the buffer of `previous_edges_count()` size
+	 */
+	void write_back_propagation_shifts(const std::vector<core::f32> &target_values, std::span<core::f32> shifts);
+	void write_back_propagation_shifts(const core::f32 prop_value, std::span<core::f32> shifts);
+
 private:
 	core::id::type mID{};
 	core::f32 mAccumulated{};
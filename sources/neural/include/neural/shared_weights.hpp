@@ -0,0 +1,54 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+
+#include "neural/activation/function.hpp"
+
+namespace golxzn::neural {
+
+class Network;
+
+/**
+ * @brief The immutable snapshot of the network weights
+ * @details The weights are stored in the single flat buffer. The block of the layer L is row-major
+ * [topology[L] + 1 (bias)][topology[L + 1]], the same layout the neural::HeaderExporter uses.
+ * The object never changes after construction, so the one `core::sptr<const SharedWeights>`
+ * is shared by any count of neural::InferenceContext on different threads.
+ */
+class SharedWeights {
+public:
+	static constexpr std::string_view class_name{ "neural::SharedWeights" };
+
+	/** @brief Copy the current weights of the network */
+	nodis static core::sptr<const SharedWeights> snapshot(const Network &network);
+
+	SharedWeights(std::vector<core::u32> &&topology,
+		std::vector<core::sptr<activation::IFunction>> &&activations,
+		std::vector<core::f32> &&weights);
+
+	nodis bool valid() const noexcept;
+
+	nodis core::u32 layers_count() const noexcept;
+	nodis core::u32 input_count() const noexcept;
+	nodis core::u32 output_count() const noexcept;
+	nodis core::u32 max_width() const noexcept;
+
+	nodis const std::vector<core::u32> &topology() const noexcept;
+	nodis const std::vector<core::sptr<activation::IFunction>> &activations() const noexcept;
+	nodis std::span<const core::f32> weights() const noexcept;
+
+	/** @brief The weights between the layer and the next one */
+	nodis std::span<const core::f32> block(const core::u32 layer) const noexcept;
+
+private:
+	std::vector<core::u32> mTopology;
+	std::vector<core::sptr<activation::IFunction>> mActivations;
+	std::vector<core::f32> mWeights;
+	std::vector<size_t> mOffsets;
+	core::u32 mMaxWidth{};
+};
+
+} // namespace golxzn::neural
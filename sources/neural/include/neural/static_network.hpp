@@ -0,0 +1,92 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <cmath>
+#include <string_view>
+#include <core/aliases.hpp>
+
+#include "neural/activation/linear_function.hpp"
+#include "neural/activation/relu_function.hpp"
+#include "neural/activation/sigmoid_function.hpp"
+#include "neural/activation/softmax_function.hpp"
+
+namespace golxzn::neural {
+
+/**
+ * @brief Inference of the model embedded by neural::HeaderExporter
+ * @details The model is the generated struct with the following static constexpr members:
+ *  - `topology`: the neuron counts of the layers without bias;
+ *  - `activations`: the activation types of the layers;
+ *  - `offsets`: the offsets of each layer-to-layer weights block in `weights`;
+ *  - `weights`: the flat weights. The block of the layer L is row-major
+ *    [topology[L] + 1 (bias)][topology[L + 1]].
+ * Every dimension is known at compile time, so the buffers live on the stack and the activations
+ * are dispatched statically.
+ */
+class StaticNetwork {
+public:
+	GOLXZN_STATIC_CLASS(StaticNetwork);
+
+	template<class Model>
+	using input_t = std::array<core::f32, Model::topology.front()>;
+
+	template<class Model>
+	using output_t = std::array<core::f32, Model::topology.back()>;
+
+	template<class Model>
+	nodis static output_t<Model> predict(const input_t<Model> &input) noexcept {
+		static_assert(Model::topology.size() >= 2, "The model must have at least input and output layers");
+		static_assert(Model::activations.size() == Model::topology.size(), "Invalid activations count");
+		static_assert(Model::offsets.size() + 1 == Model::topology.size(), "Invalid offsets count");
+		return forward<Model, 0>(input);
+	}
+
+private:
+	template<class Model, size_t Layer>
+	static auto forward(const std::array<core::f32, Model::topology[Layer]> &values) noexcept {
+		if constexpr (Layer + 1 == Model::topology.size()) {
+			return values;
+		} else {
+			static constexpr auto in_count{ Model::topology[Layer] };
+			static constexpr auto out_count{ Model::topology[Layer + 1] };
+			static constexpr auto type{ Model::activations[Layer + 1] };
+			const auto weights{ std::span{ Model::weights }.subspan(Model::offsets[Layer], (in_count + 1) * out_count) };
+
+			std::array<core::f32, out_count> next{};
+			const auto bias{ weights.subspan(in_count * out_count, out_count) };
+			std::copy(std::begin(bias), std::end(bias), std::begin(next));
+			for (size_t i{}; i < in_count; ++i) {
+				const auto row{ weights.subspan(i * out_count, out_count) };
+				for (size_t j{}; j < out_count; ++j) {
+					next[j] += values[i] * row[j];
+				}
+			}
+
+			for (auto &value : next) {
+				value = activate<Model, Layer + 1>(value);
+			}
+			if constexpr (type == activation::SoftmaxFunction::type) {
+				activation::SoftmaxFunction::forward(next, next);
+			}
+			return forward<Model, Layer + 1>(next);
+		}
+	}
+
+	template<class Model, size_t Layer>
+	static core::f32 activate(const core::f32 x) noexcept {
+		using namespace core::types_literals;
+		static constexpr auto type{ Model::activations[Layer] };
+		if constexpr (type == activation::SigmoidFunction::type) {
+			return 1.0_f32 / (1.0_f32 + std::exp(-x));
+		} else if constexpr (type == activation::ReLUFunction::type) {
+			return x > 0.0_f32 ? x : 0.0_f32;
+		} else {
+			static_assert(type == activation::LinearFunction::type || type == activation::SoftmaxFunction::type,
+				"Unsupported activation function");
+			return x;
+		}
+	}
+};
+
+} // namespace golxzn::neural
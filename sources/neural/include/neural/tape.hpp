@@ -0,0 +1,118 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <string_view>
+#include <core/aliases.hpp>
+#include <core/constants.hpp>
+
+namespace golxzn::neural {
+
+/**
+ * @brief Reverse-mode automatic differentiation tape
+ * @details The forward operations are recorded into the arena as they're executed. Each record
+ * stores its value, up to two parents and the local partial derivatives with respect to them,
+ * so `backward` replays the adjoints in the single reverse sweep without any virtual calls.
+ * The arena is never shrunk: `reset` is O(1) and the next batch reuses the same memory.
+ *
+ * Usage:
+ *   Tape tape;
+ *   const auto x{ tape.variable(2.0) };
+ *   const auto y{ exp(x * x) + x };
+ *   tape.backward(y);
+ *   tape.adjoint(x); // dy/dx
+ */
+class Tape {
+public:
+	using value_type = core::f32;
+	using index_type = core::u32;
+
+	class Variable;
+
+	static constexpr std::string_view class_name{ "neural::Tape" };
+	static constexpr index_type no_parent{ core::invalid_id<index_type>() };
+
+	Tape() = default;
+	explicit Tape(const size_t capacity);
+
+	nodis Variable variable(const value_type value);
+	nodis std::vector<Variable> variables(std::span<const value_type> values);
+
+	/** @brief Record the operation with the precomputed local partials */
+	nodis Variable record(const value_type value,
+		const index_type lhs, const value_type lhs_partial,
+		const index_type rhs = no_parent, const value_type rhs_partial = value_type{});
+
+	nodis value_type value(const Variable &variable) const noexcept;
+	nodis value_type adjoint(const Variable &variable) const noexcept;
+	nodis std::span<const value_type> adjoints() const noexcept;
+
+	/**
+	 * @brief Replay the adjoints from the output to the inputs
+	 * @param output the variable to be differentiated. Its adjoint is seeded with `seed`
+	 */
+	void backward(const Variable &output, const value_type seed = value_type{ 1 }) noexcept;
+
+	/** @brief Forget all records. The memory is kept for the next batch */
+	void reset() noexcept;
+	void reserve(const size_t capacity);
+
+	nodis size_t size() const noexcept;
+	nodis size_t capacity() const noexcept;
+
+	nodis Variable sum(std::span<const Variable> values);
+	nodis Variable dot(std::span<const Variable> lhs, std::span<const Variable> rhs);
+
+private:
+	size_t mSize{};
+	std::vector<value_type> mValues;
+	std::vector<value_type> mAdjoints;
+	std::vector<index_type> mLhs;
+	std::vector<index_type> mRhs;
+	std::vector<value_type> mLhsPartials;
+	std::vector<value_type> mRhsPartials;
+
+	void grow();
+};
+
+/** @brief The handle of the recorded value. It's valid until the tape is reset */
+class Tape::Variable {
+	friend class Tape;
+public:
+	Variable() = default;
+
+	nodis Tape *tape() const noexcept { return mTape; }
+	nodis index_type index() const noexcept { return mIndex; }
+	nodis value_type value() const noexcept { return mTape->value(*this); }
+	nodis value_type adjoint() const noexcept { return mTape->adjoint(*this); }
+
+private:
+	Tape *mTape{ nullptr };
+	index_type mIndex{ no_parent };
+
+	Variable(Tape *tape, const index_type index) noexcept : mTape{ tape }, mIndex{ index } {}
+};
+
+nodis Tape::Variable operator+(const Tape::Variable &lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator-(const Tape::Variable &lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator*(const Tape::Variable &lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator/(const Tape::Variable &lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator-(const Tape::Variable &value);
+
+nodis Tape::Variable operator+(const Tape::Variable &lhs, const Tape::value_type rhs);
+nodis Tape::Variable operator-(const Tape::Variable &lhs, const Tape::value_type rhs);
+nodis Tape::Variable operator*(const Tape::Variable &lhs, const Tape::value_type rhs);
+nodis Tape::Variable operator/(const Tape::Variable &lhs, const Tape::value_type rhs);
+nodis Tape::Variable operator+(const Tape::value_type lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator-(const Tape::value_type lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator*(const Tape::value_type lhs, const Tape::Variable &rhs);
+nodis Tape::Variable operator/(const Tape::value_type lhs, const Tape::Variable &rhs);
+
+nodis Tape::Variable exp(const Tape::Variable &value);
+nodis Tape::Variable log(const Tape::Variable &value);
+nodis Tape::Variable tanh(const Tape::Variable &value);
+nodis Tape::Variable sigmoid(const Tape::Variable &value);
+nodis Tape::Variable relu(const Tape::Variable &value);
+nodis Tape::Variable square(const Tape::Variable &value);
+
+} // namespace golxzn::neural
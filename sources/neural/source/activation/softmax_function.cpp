@@ -0,0 +1,72 @@
+#include "neural/activation/softmax_function.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <core/common>
+
+namespace golxzn::neural::activation {
+
+SoftmaxFunction::SoftmaxFunction() noexcept : IFunction{ std::string{ type } } {}
+
+core::f32 SoftmaxFunction::execute(core::f32 x) const noexcept { return x; }
+core::f32 SoftmaxFunction::derivative([[maybe_unused]] core::f32 x) const noexcept {
+	using namespace core::types_literals;
+	return 1.0_f32;
+}
+
+void SoftmaxFunction::forward(std::span<const core::f32> logits, std::span<core::f32> probabilities) noexcept {
+	if (logits.size() != probabilities.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid probabilities size ({} != {})",
+			class_name.data(), probabilities.size(), logits.size());
+		return;
+	}
+	if (logits.empty()) [[unlikely]] return;
+
+	const auto max{ *std::ranges::max_element(logits) };
+	core::f32 sum{};
+	for (size_t i{}; i < logits.size(); ++i) {
+		probabilities[i] = std::exp(logits[i] - max);
+		sum += probabilities[i];
+	}
+	for (auto &probability : probabilities) {
+		probability /= sum;
+	}
+}
+
+std::optional<core::f32> SoftmaxFunction::cross_entropy(std::span<const core::f32> logits,
+		std::span<const core::f32> target, std::span<core::f32> gradient) noexcept {
+	using namespace core::types_literals;
+	if (logits.size() != target.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid target size ({} != {})", class_name.data(), target.size(), logits.size());
+		return std::nullopt;
+	}
+	if (!gradient.empty() && gradient.size() != logits.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid gradient size ({} != {})", class_name.data(), gradient.size(), logits.size());
+		return std::nullopt;
+	}
+	if (logits.empty()) [[unlikely]] return 0.0_f32;
+
+	const auto max{ *std::ranges::max_element(logits) };
+	const auto lse{ log_sum_exp(logits, max) };
+
+	core::f32 loss{};
+	/// The logit is read before the gradient is written, so both of them could be the same buffer
+	for (size_t i{}; i < logits.size(); ++i) {
+		const auto log_probability{ logits[i] - lse };
+		loss -= target[i] * log_probability;
+		if (!gradient.empty()) {
+			gradient[i] = std::exp(log_probability) - target[i];
+		}
+	}
+	return loss;
+}
+
+core::f32 SoftmaxFunction::log_sum_exp(std::span<const core::f32> logits, const core::f32 max) noexcept {
+	core::f32 sum{};
+	for (const auto logit : logits) {
+		sum += std::exp(logit - max);
+	}
+	return max + std::log(sum);
+}
+
+} // namespace golxzn::neural::activation
@@ -0,0 +1,26 @@
+#include "neural/activation/tape_function.hpp"
+
+namespace golxzn::neural::activation {
+
+TapeFunction::TapeFunction(const std::string &type) noexcept : IFunction{ type } {}
+
+core::f32 TapeFunction::execute(core::f32 x) const noexcept {
+	auto &tape{ local_tape() };
+	tape.reset();
+	return expression(tape.variable(x)).value();
+}
+
+core::f32 TapeFunction::derivative(core::f32 x) const noexcept {
+	auto &tape{ local_tape() };
+	tape.reset();
+	const auto input{ tape.variable(x) };
+	tape.backward(expression(input));
+	return input.adjoint();
+}
+
+Tape &TapeFunction::local_tape() noexcept {
+	thread_local Tape tape;
+	return tape;
+}
+
+} // namespace golxzn::neural::activation
@@ -0,0 +1,116 @@
+#include <core/common>
+
+#include "neural/batch_prefetcher.hpp"
+
+namespace golxzn::neural {
+
+BatchPrefetcher::BatchPrefetcher(const Dataset &dataset, const Dataset::Type type)
+	: BatchPrefetcher{ dataset, dataset.get_lines(type), Settings{} } {}
+
+BatchPrefetcher::BatchPrefetcher(const Dataset &dataset, const Dataset::Type type, const Settings &settings)
+	: BatchPrefetcher{ dataset, dataset.get_lines(type), settings } {}
+
+BatchPrefetcher::BatchPrefetcher(const Dataset &dataset, std::span<const core::u32> lines, const Settings &settings)
+	: mDataset{ dataset }, mLines{ lines }, mSettings{ settings } {
+	if (mSettings.statistics != nullptr && (mSettings.statistics->get_input_count() != dataset.get_input_count()
+			|| mSettings.statistics->get_output_count() != dataset.get_output_count())) [[unlikely]] {
+		spdlog::error("[{}]: The statistics are computed for the different line size", class_name.data());
+		mSettings.statistics.reset();
+	}
+
+	mSettings.batch_size = (std::max)(mSettings.batch_size, core::u32{ 1 });
+	mSettings.prefetch_count = (std::max)(mSettings.prefetch_count, core::u32{ 1 });
+
+	/// The prefetched batches and the one being trained
+	mBuffers.resize(mSettings.prefetch_count + 1);
+	for (auto &buffer : mBuffers) {
+		buffer.inputs = allocate(static_cast<size_t>(mSettings.batch_size) * dataset.get_input_count());
+		buffer.outputs = allocate(static_cast<size_t>(mSettings.batch_size) * dataset.get_output_count());
+	}
+	start();
+}
+
+BatchPrefetcher::~BatchPrefetcher() {
+	mRing.stop();
+}
+
+BatchPrefetcher::Batch BatchPrefetcher::next() {
+	const auto filled{ mRing.take() };
+	if (!filled.has_value()) return {};
+
+	const auto [buffer, size]{ *filled };
+	Batch batch;
+	batch.mInputs = { mBuffers[buffer].inputs.get(), static_cast<size_t>(size) * mDataset.get_input_count() };
+	batch.mOutputs = { mBuffers[buffer].outputs.get(), static_cast<size_t>(size) * mDataset.get_output_count() };
+	batch.mSize = size;
+	return batch;
+}
+
+void BatchPrefetcher::restart() {
+	mRing.stop();
+	start();
+}
+
+const BatchPrefetcher::Settings &BatchPrefetcher::settings() const noexcept { return mSettings; }
+
+BatchPrefetcher::Metrics BatchPrefetcher::metrics() const {
+	const auto ring{ mRing.metrics() };
+	Metrics metrics;
+	metrics.batches = ring.taken;
+	metrics.stall_time = ring.stall_time;
+	metrics.occupancy = ring.occupancy;
+	if (ring.taken != 0) {
+		metrics.average_occupancy = static_cast<core::f64>(ring.occupancy_sum) / ring.taken;
+	}
+
+	std::lock_guard lock{ mMetricsMutex };
+	metrics.gather_time = mGatherTime;
+	return metrics;
+}
+
+void BatchPrefetcher::start() {
+	/// The helper thread isn't running, so the order is copied before the dataset is reshuffled again
+	mOrder.assign(std::begin(mLines), std::end(mLines));
+	mRing.start(static_cast<core::u32>(mBuffers.size()), [this] { gather(); });
+}
+
+void BatchPrefetcher::gather() {
+	const auto batch_size{ static_cast<size_t>(mSettings.batch_size) };
+	const std::span order{ mOrder };
+	for (size_t first{}; first < order.size(); first += batch_size) {
+		const auto lines{ order.subspan(first, std::min(batch_size, order.size() - first)) };
+		if (mSettings.drop_last && lines.size() < batch_size) break;
+
+		const auto buffer{ mRing.acquire() };
+		if (!buffer.has_value()) break;
+
+		const auto gather_start{ clock::now() };
+		gather_batch(mBuffers[*buffer], lines);
+		const auto gather_time{ std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - gather_start) };
+		{
+			std::lock_guard lock{ mMetricsMutex };
+			mGatherTime += gather_time;
+		}
+		mRing.publish(*buffer, static_cast<core::u32>(lines.size()));
+	}
+}
+
+void BatchPrefetcher::gather_batch(const Buffer &buffer, std::span<const core::u32> lines) const {
+	const auto input_count{ static_cast<size_t>(mDataset.get_input_count()) };
+	const auto output_count{ static_cast<size_t>(mDataset.get_output_count()) };
+	for (size_t i{}; i < lines.size(); ++i) {
+		const std::span input{ buffer.inputs.get() + i * input_count, input_count };
+		const std::span output{ buffer.outputs.get() + i * output_count, output_count };
+		mDataset.read_line(lines[i], input, output);
+		if (mSettings.statistics != nullptr) {
+			mSettings.statistics->standardize_input(input);
+		}
+	}
+}
+
+BatchPrefetcher::buffer_t BatchPrefetcher::allocate(const size_t count) {
+	const auto bytes{ std::max<size_t>(count, 1) * sizeof(value_type) };
+	return buffer_t{ static_cast<value_type *>(::operator new[](bytes, std::align_val_t{ alignment })) };
+}
+
+} // namespace golxzn::neural
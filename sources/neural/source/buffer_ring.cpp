@@ -0,0 +1,93 @@
+#include <core/common>
+
+#include "neural/buffer_ring.hpp"
+
+namespace golxzn::neural {
+
+BufferRing::~BufferRing() {
+	stop();
+}
+
+void BufferRing::start(const core::u32 buffers_count, std::function<void()> producer) {
+	{
+		std::lock_guard lock{ mMutex };
+		mFree.clear();
+		for (core::u32 buffer{}; buffer < buffers_count; ++buffer) {
+			mFree.push_back(buffer);
+		}
+		mFilled.clear();
+		mCurrent.reset();
+		mFinished = false;
+		mRunning = true;
+	}
+	mProducer = std::thread{ [this, producer = std::move(producer)] {
+		producer();
+
+		std::lock_guard lock{ mMutex };
+		mFinished = true;
+		mCondition.notify_all();
+	} };
+}
+
+void BufferRing::stop() {
+	{
+		std::lock_guard lock{ mMutex };
+		mRunning = false;
+	}
+	mCondition.notify_all();
+	if (mProducer.joinable()) mProducer.join();
+}
+
+std::optional<core::u32> BufferRing::acquire() {
+	std::unique_lock lock{ mMutex };
+	mCondition.wait(lock, [this] { return !mFree.empty() || !mRunning; });
+	if (!mRunning) return std::nullopt;
+
+	const auto buffer{ mFree.back() };
+	mFree.pop_back();
+	return buffer;
+}
+
+void BufferRing::publish(const core::u32 buffer, const core::u32 size) {
+	std::lock_guard lock{ mMutex };
+	mFilled.push_back(Filled{ buffer, size });
+	mCondition.notify_all();
+}
+
+void BufferRing::release(const core::u32 buffer) {
+	std::lock_guard lock{ mMutex };
+	mFree.push_back(buffer);
+	mCondition.notify_all();
+}
+
+std::optional<BufferRing::Filled> BufferRing::take() {
+	std::unique_lock lock{ mMutex };
+	if (mCurrent.has_value()) {
+		mFree.push_back(*mCurrent);
+		mCurrent.reset();
+		mCondition.notify_all();
+	}
+
+	mMetrics.occupancy_sum += mFilled.size();
+	if (mFilled.empty() && !mFinished) {
+		const auto stall_start{ clock::now() };
+		mCondition.wait(lock, [this] { return !mFilled.empty() || mFinished; });
+		mMetrics.stall_time += std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - stall_start);
+	}
+	if (mFilled.empty()) return std::nullopt;
+
+	const auto filled{ mFilled.front() };
+	mFilled.pop_front();
+	mCurrent = filled.buffer;
+	++mMetrics.taken;
+	return filled;
+}
+
+BufferRing::Metrics BufferRing::metrics() const {
+	std::lock_guard lock{ mMutex };
+	auto metrics{ mMetrics };
+	metrics.occupancy = static_cast<core::u32>(mFilled.size());
+	return metrics;
+}
+
+} // namespace golxzn::neural
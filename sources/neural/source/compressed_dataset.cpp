@@ -0,0 +1,268 @@
+#include <zlib.h>
+#include <atomic>
+#include <future>
+#include <thread>
+#include <core/common>
+#include <core/resources/manager.hpp>
+
+#include "neural/compressed_dataset.hpp"
+
+namespace golxzn::neural {
+
+namespace {
+
+constexpr size_t header_size{ 6 * sizeof(core::u32) + sizeof(core::u64) };
+constexpr size_t index_entry_size{ sizeof(core::u64) + 2 * sizeof(core::u32) };
+
+template<class T>
+void write_value(std::vector<core::byte> &output, size_t &offset, const T value) noexcept {
+	std::memcpy(output.data() + offset, &value, sizeof(T));
+	offset += sizeof(T);
+}
+
+template<class T>
+T read_value(std::span<const core::byte> input, size_t &offset) noexcept {
+	T value{};
+	std::memcpy(&value, input.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+} // anonymous namespace
+
+std::vector<core::byte> CompressedDataset::compress(const Dataset &dataset) {
+	return compress(dataset, Settings{});
+}
+
+std::vector<core::byte> CompressedDataset::compress(const Dataset &dataset, const Settings &settings) {
+	if (dataset.empty()) [[unlikely]] return {};
+
+	std::vector<core::byte> transposed;
+	std::span<const core::byte> bytes;
+	if (dataset.layout() == Dataset::Layout::RowMajor) {
+		const auto values{ dataset.data() };
+		bytes = { reinterpret_cast<const core::byte *>(values.data()), values.size_bytes() };
+	} else {
+		transposed = dataset.raw();
+		bytes = transposed;
+	}
+
+	const auto line_bytes{ static_cast<size_t>(dataset.line_size()) * Dataset::value_size };
+	const auto lines_per_block{ (std::max)(settings.lines_per_block, core::u32{ 1 }) };
+	const auto blocks_count{ (dataset.lines_count() + lines_per_block - 1) / lines_per_block };
+
+	std::vector<std::vector<core::byte>> blocks(blocks_count);
+	std::atomic<core::u32> next_block{};
+	std::atomic<bool> failed{ false };
+	{
+		std::vector<std::jthread> workers;
+		const auto threads_count{ std::min(threads_or_default(settings.threads_count), blocks_count) };
+		for (core::u32 i{}; i < threads_count; ++i) {
+			workers.emplace_back([&] {
+				for (auto block{ next_block++ }; block < blocks_count; block = next_block++) {
+					const auto begin{ static_cast<size_t>(block) * lines_per_block * line_bytes };
+					const auto size{ std::min(lines_per_block * line_bytes, bytes.size() - begin) };
+
+					auto &output{ blocks[block] };
+					auto output_size{ compressBound(static_cast<uLong>(size)) };
+					output.resize(output_size);
+					const auto status{ compress2(output.data(), &output_size,
+						reinterpret_cast<const Bytef *>(bytes.data() + begin), static_cast<uLong>(size),
+						std::clamp(settings.level, core::i32{ 1 }, core::i32{ 9 })) };
+					if (status != Z_OK) [[unlikely]] {
+						failed = true;
+						return;
+					}
+					output.resize(output_size);
+				}
+			});
+		}
+	}
+	if (failed) [[unlikely]] {
+		spdlog::error("[{}]: Cannot compress the dataset", class_name.data());
+		return {};
+	}
+
+	const auto blocks_offset{ header_size + blocks_count * index_entry_size };
+	const auto total_size{ std::accumulate(std::begin(blocks), std::end(blocks), blocks_offset,
+		[](const size_t sum, const auto &block) { return sum + block.size(); }) };
+
+	std::vector<core::byte> result(total_size);
+	size_t offset{};
+	write_value(result, offset, magic);
+	write_value(result, offset, version);
+	write_value(result, offset, dataset.get_input_count());
+	write_value(result, offset, dataset.get_output_count());
+	write_value(result, offset, lines_per_block);
+	write_value(result, offset, blocks_count);
+	write_value(result, offset, static_cast<core::u64>(dataset.lines_count()));
+
+	auto block_offset{ static_cast<core::u64>(blocks_offset) };
+	for (core::u32 block{}; block < blocks_count; ++block) {
+		const auto first_line{ block * lines_per_block };
+		write_value(result, offset, block_offset);
+		write_value(result, offset, static_cast<core::u32>(blocks[block].size()));
+		write_value(result, offset, std::min(lines_per_block, dataset.lines_count() - first_line));
+		std::ranges::copy(blocks[block], std::begin(result) + block_offset);
+		block_offset += blocks[block].size();
+	}
+	return result;
+}
+
+bool CompressedDataset::save(const Dataset &dataset, const std::string_view path, const Settings &settings) {
+	const auto content{ compress(dataset, settings) };
+	if (content.empty()) [[unlikely]] return false;
+	return core::resources::manager::save_binary(path, content);
+}
+
+CompressedDataset::CompressedDataset(const std::string_view file) {
+	mMapping = core::resources::manager::map(file);
+	mBytes = mMapping.data();
+	parse();
+}
+
+CompressedDataset::CompressedDataset(std::vector<core::byte> &&content) : mContent{ std::move(content) } {
+	mBytes = mContent;
+	parse();
+}
+
+bool CompressedDataset::is_open() const noexcept { return !mBlocks.empty(); }
+core::u32 CompressedDataset::get_input_count() const noexcept { return mInputCount; }
+core::u32 CompressedDataset::get_output_count() const noexcept { return mOutputCount; }
+core::u64 CompressedDataset::lines_count() const noexcept { return mLinesCount; }
+core::u32 CompressedDataset::blocks_count() const noexcept { return static_cast<core::u32>(mBlocks.size()); }
+
+core::u32 CompressedDataset::block_lines_count(const core::u32 block) const noexcept {
+	return block < mBlocks.size() ? mBlocks[block].lines_count : core::u32{};
+}
+
+size_t CompressedDataset::compressed_size() const noexcept { return mBytes.size(); }
+
+bool CompressedDataset::read_block(const core::u32 block, std::vector<value_type> &lines) const {
+	if (block >= mBlocks.size()) [[unlikely]] return false;
+
+	lines.resize(static_cast<size_t>(mBlocks[block].lines_count) * (mInputCount + mOutputCount));
+	return decompress(block, lines);
+}
+
+bool CompressedDataset::stream(const block_callback &callback, const core::u32 threads_count) const {
+	if (!is_open() || !callback) [[unlikely]] return false;
+
+	using window_t = std::vector<std::future<std::vector<value_type>>>;
+	const auto window_size{ threads_or_default(threads_count) };
+	const auto launch{ [this, window_size](const core::u32 first) {
+		window_t window;
+		for (auto block{ first }; block < std::min<size_t>(first + window_size, mBlocks.size()); ++block) {
+			window.emplace_back(std::async(std::launch::async, [this, block] {
+				std::vector<value_type> lines;
+				if (!read_block(block, lines)) lines.clear();
+				return lines;
+			}));
+		}
+		return window;
+	} };
+
+	auto current{ launch(0) };
+	for (core::u32 first{}; first < mBlocks.size(); first += window_size) {
+		auto next{ launch(first + window_size) };
+		for (core::u32 i{}; i < current.size(); ++i) {
+			const auto lines{ current[i].get() };
+			if (lines.empty()) [[unlikely]] return false;
+			callback(first + i, lines);
+		}
+		current = std::move(next);
+	}
+	return true;
+}
+
+Dataset CompressedDataset::load(const core::u32 threads_count) const {
+	if (!is_open()) [[unlikely]] return {};
+
+	const auto line_size{ static_cast<size_t>(mInputCount) + mOutputCount };
+	std::vector<value_type> values(mLinesCount * line_size);
+
+	std::atomic<core::u32> next_block{};
+	std::atomic<bool> failed{ false };
+	{
+		std::vector<std::jthread> workers;
+		const auto workers_count{ std::min(threads_or_default(threads_count), blocks_count()) };
+		for (core::u32 i{}; i < workers_count; ++i) {
+			workers.emplace_back([&] {
+				for (auto block{ next_block++ }; block < mBlocks.size(); block = next_block++) {
+					const auto lines{ std::span{ values }.subspan(mFirstLines[block] * line_size,
+						static_cast<size_t>(mBlocks[block].lines_count) * line_size) };
+					if (!decompress(block, lines)) failed = true;
+				}
+			});
+		}
+	}
+	if (failed) [[unlikely]] return {};
+	return Dataset{ std::move(values), mInputCount, mOutputCount };
+}
+
+void CompressedDataset::parse() {
+	if (mBytes.size() < header_size) [[unlikely]] {
+		spdlog::error("[{}]: The content is too small", class_name.data());
+		return;
+	}
+
+	size_t offset{};
+	const auto file_magic{ read_value<core::u32>(mBytes, offset) };
+	const auto file_version{ read_value<core::u32>(mBytes, offset) };
+	if (file_magic != magic || file_version != version) [[unlikely]] {
+		spdlog::error("[{}]: Unsupported format {:#x} version {}", class_name.data(), file_magic, file_version);
+		return;
+	}
+
+	mInputCount = read_value<core::u32>(mBytes, offset);
+	mOutputCount = read_value<core::u32>(mBytes, offset);
+	[[maybe_unused]] const auto lines_per_block{ read_value<core::u32>(mBytes, offset) };
+	const auto blocks_count{ read_value<core::u32>(mBytes, offset) };
+	mLinesCount = read_value<core::u64>(mBytes, offset);
+	if (mInputCount == 0 || mOutputCount == 0 || mBytes.size() < header_size + blocks_count * index_entry_size) [[unlikely]] {
+		spdlog::error("[{}]: The header is corrupted", class_name.data());
+		return;
+	}
+
+	std::vector<Block> blocks(blocks_count);
+	std::vector<core::u64> first_lines(blocks_count);
+	core::u64 lines{};
+	for (core::u32 i{}; i < blocks_count; ++i) {
+		auto &block{ blocks[i] };
+		block.offset = read_value<core::u64>(mBytes, offset);
+		block.compressed_size = read_value<core::u32>(mBytes, offset);
+		block.lines_count = read_value<core::u32>(mBytes, offset);
+		if (block.offset + block.compressed_size > mBytes.size()) [[unlikely]] {
+			spdlog::error("[{}]: The block {} is out of the content", class_name.data(), i);
+			return;
+		}
+		first_lines[i] = lines;
+		lines += block.lines_count;
+	}
+	if (lines != mLinesCount) [[unlikely]] {
+		spdlog::error("[{}]: The blocks have {} lines instead of {}", class_name.data(), lines, mLinesCount);
+		return;
+	}
+
+	mBlocks = std::move(blocks);
+	mFirstLines = std::move(first_lines);
+}
+
+bool CompressedDataset::decompress(const core::u32 block, std::span<value_type> lines) const {
+	const auto &info{ mBlocks[block] };
+	const auto expected_size{ lines.size() * Dataset::value_size };
+	auto size{ static_cast<uLongf>(expected_size) };
+	const auto status{ uncompress(reinterpret_cast<Bytef *>(lines.data()), &size,
+		reinterpret_cast<const Bytef *>(mBytes.data() + info.offset), info.compressed_size) };
+	if (status != Z_OK || size != expected_size) [[unlikely]] {
+		spdlog::error("[{}]: Cannot decompress the block {} ({})", class_name.data(), block, status);
+		return false;
+	}
+	return true;
+}
+
+core::u32 CompressedDataset::threads_or_default(const core::u32 threads_count) noexcept {
+	return threads_count != 0 ? threads_count : (std::max)(std::thread::hardware_concurrency(), 1u);
+}
+
+} // namespace golxzn::neural
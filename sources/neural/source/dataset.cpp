@@ -1,152 +1,463 @@
+#include <cmath>
 #include <execution>
 #include <core/common>
 #include <core/utils/random.hpp>
 #include <core/resources/manager.hpp>
 
 #include "neural/dataset.hpp"
+#include "neural/dataset_format.hpp"
+#include "neural/feature_statistics.hpp"
 
 namespace golxzn::neural {
 
-Dataset::Dataset(const std::vector<core::byte> &raw_data, const core::u32 input_count, const core::u32 output_count) {
+Dataset::Dataset(const Layout layout) : mLayout{ layout } {}
+
+Dataset::Dataset(const std::vector<core::byte> &raw_data, const core::u32 input_count, const core::u32 output_count,
+		const Layout layout) : mLayout{ layout } {
 	if (raw_data.empty()) [[unlikely]] return;
 
 	load_from_raw_data(raw_data.data(), raw_data.size(), input_count, output_count);
 }
 
-Dataset::Dataset(const std::string_view file, const core::u32 input_count, const core::u32 output_count)
-	: Dataset{ core::resources::manager::load_binary(file), input_count, output_count } { }
+Dataset::Dataset(const std::string_view file, const core::u32 input_count, const core::u32 output_count,
+		const Layout layout)
+	: Dataset{ core::resources::manager::load_binary(file), input_count, output_count, layout } { }
+
+Dataset::Dataset(std::vector<value_type> &&data, const core::u32 input_count, const core::u32 output_count,
+		const Layout layout) {
+	if (input_count == 0 || output_count == 0) [[unlikely]] {
+		spdlog::error("[{}]: Invalid line size ({} inputs, {} outputs)", class_name.data(), input_count, output_count);
+		return;
+	}
+
+	const auto line_size{ static_cast<size_t>(input_count) + output_count };
+	if (data.size() % line_size != 0 || data.size() / line_size > core::invalid_id<core::u32>()) [[unlikely]] {
+		spdlog::error("[{}]: {} values aren't the whole lines of {}", class_name.data(), data.size(), line_size);
+		return;
+	}
+
+	mInputCount = input_count;
+	mOutputCount = output_count;
+	mLinesCount = static_cast<core::u32>(data.size() / line_size);
+	mData = std::move(data);
+	set_layout(layout);
+}
 
-Dataset::Dataset(const std::string_view file) {
+Dataset::Dataset(const std::string_view file, const Layout layout) : mLayout{ layout } {
 	const auto raw_data{ core::resources::manager::load_binary(file) };
 	if (raw_data.empty()) [[unlikely]] return;
 
+	if (DatasetFormat::is_formatted(raw_data)) {
+		*this = DatasetFormat::decode(raw_data, layout);
+		return;
+	}
+
 	const auto [offset, input_size, output_size]{ get_input_and_output_count(raw_data) };
 	const auto data_length{ raw_data.size() - offset };
 
 	load_from_raw_data(raw_data.data() + offset, data_length, input_size, output_size);
 }
 
+Dataset Dataset::map(const std::string_view file, const core::u32 input_count, const core::u32 output_count) {
+	Dataset dataset;
+	dataset.map_from(core::resources::manager::map(file), 0, input_count, output_count);
+	return dataset;
+}
+
+Dataset Dataset::map(const std::string_view file) {
+	static constexpr size_t count_fields_size{ count_value_size * 2 };
+
+	Dataset dataset;
+	auto mapping{ core::resources::manager::map(file) };
+	if (mapping.empty()) [[unlikely]] return dataset;
+
+	if (DatasetFormat::is_formatted(mapping.data())) {
+		const auto header{ DatasetFormat::read_header(mapping.data()) };
+		if (!header.has_value()) [[unlikely]] return dataset;
+
+		/// Only the f64 elements without the scale are the same as the compute values
+		if (header->type != DatasetFormat::ElementType::F64 || !header->is_identity()) {
+			return DatasetFormat::decode(mapping.data());
+		}
+		dataset.map_from(std::move(mapping), header->data_offset, header->input_count, header->output_count);
+		return dataset;
+	}
+	if (mapping.size() < count_fields_size) [[unlikely]] {
+		spdlog::error("[{}]: The file '{}' has no header", class_name.data(), file);
+		return dataset;
+	}
+
+	std::array<count_value_type, 2> counts{};
+	std::memcpy(counts.data(), mapping.data().data(), count_fields_size);
+	dataset.map_from(std::move(mapping), count_fields_size, counts[0], counts[1]);
+	return dataset;
+}
+
 void Dataset::split(const core::f32 ratio) {
-	using namespace core::types_literals;
-
-	mTrainDataInput.clear();
-	mTrainDataOutput.clear();
-	mTestDataInput.clear();
-	mTestDataOutput.clear();
-
-	/// @todo: it could cause out of range crush
-	for (core::u32 id{}; id < mInputData.size(); ++id) {
-		if (core::utils::random::range(0.0_f32, 1.0_f32) < ratio) {
-			mTrainDataInput.emplace_back(std::cref(mInputData.at(id)));
-			mTrainDataOutput.emplace_back(std::cref(mOutputData.at(id)));
-		} else {
-			mTestDataInput.emplace_back(std::cref(mInputData.at(id)));
-			mTestDataOutput.emplace_back(std::cref(mOutputData.at(id)));
+	split(ratio, core::utils::random::seed());
+}
+
+void Dataset::split(const core::f32 ratio, const core::u64 seed) {
+	reset_order();
+	core::utils::xoshiro256 engine{ seed };
+	engine.shuffle(std::span{ mOrder });
+	mTrainCount = static_cast<core::u32>(std::lround(std::clamp(ratio, 0.0, 1.0) * mLinesCount));
+}
+
+void Dataset::split_stratified(const core::f32 ratio, const core::u64 seed) {
+	std::map<core::u64, lines_t> classes;
+	for (core::u32 line{}; line < mLinesCount; ++line) {
+		const auto line_class{ class_of(line) };
+		if (!line_class.has_value()) [[unlikely]] {
+			spdlog::warn("[{}]: The output of the line {} isn't a class. Falling back to the random split",
+				class_name.data(), line);
+			split(ratio, seed);
+			return;
 		}
+		classes[*line_class].push_back(line);
+	}
+	clean_split();
+
+	/// Largest remainders: each class gets the floor of its share, and the lines left to reach
+	/// the global train count go to the classes with the greatest fractional parts
+	const auto clamped{ std::clamp(ratio, 0.0, 1.0) };
+	const auto total_train{ static_cast<size_t>(std::lround(clamped * mLinesCount)) };
+	std::vector<size_t> train_counts;
+	std::vector<std::pair<core::f64, size_t>> remainders;
+	train_counts.reserve(classes.size());
+	remainders.reserve(classes.size());
+	size_t assigned{};
+	for (const auto &[_, lines] : classes) {
+		const auto share{ clamped * static_cast<core::f64>(lines.size()) };
+		const auto count{ static_cast<size_t>(std::floor(share)) };
+		remainders.emplace_back(share - static_cast<core::f64>(count), train_counts.size());
+		train_counts.push_back(count);
+		assigned += count;
+	}
+	std::ranges::stable_sort(remainders, std::greater{}, &std::pair<core::f64, size_t>::first);
+	for (size_t i{}; assigned < total_train && i < remainders.size(); ++i, ++assigned) {
+		++train_counts[remainders[i].second];
 	}
 
-	// for (core::u32 id{}; id < mOutputData.size(); ++id) {
-	// 	if (core::utils::random::range(0.0_f32, 1.0_f32) < ratio) {
-	// 		mTrainDataOutput.emplace_back(std::cref(mOutputData.at(id)));
-	// 	} else {
-	// 		mTestDataOutput.emplace_back(std::cref(mOutputData.at(id)));
-	// 	}
-	// }
+	core::utils::xoshiro256 engine{ seed };
+	lines_t test;
+	mOrder.reserve(mLinesCount);
+	size_t class_index{};
+	for (auto &[_, lines] : classes) {
+		engine.shuffle(std::span{ lines });
+		const auto train_count{ train_counts[class_index++] };
+		mOrder.insert(std::end(mOrder), std::begin(lines), std::begin(lines) + train_count);
+		test.insert(std::end(test), std::begin(lines) + train_count, std::end(lines));
+	}
+	mTrainCount = static_cast<core::u32>(mOrder.size());
+	engine.shuffle(std::span{ mOrder });
+	engine.shuffle(std::span{ test });
+	mOrder.insert(std::end(mOrder), std::begin(test), std::end(test));
 }
 
-const Dataset::data_ref_t<Dataset::value_type> &Dataset::get_input(const Type type) const noexcept {
-	if (type == Type::Train) {
-		return mTrainDataInput;
+void Dataset::split_fold(const core::u32 folds, const core::u32 fold, const core::u64 seed) {
+	if (folds < 2 || fold >= folds) [[unlikely]] {
+		spdlog::error("[{}]: Invalid fold {} of {}", class_name.data(), fold, folds);
+		return;
 	}
-	return mTestDataInput;
+
+	reset_order();
+	core::utils::xoshiro256 engine{ seed };
+	engine.shuffle(std::span{ mOrder });
+
+	const auto begin{ static_cast<size_t>(mLinesCount) * fold / folds };
+	const auto end{ static_cast<size_t>(mLinesCount) * (fold + 1) / folds };
+	std::rotate(std::begin(mOrder) + begin, std::begin(mOrder) + end, std::end(mOrder));
+	mTrainCount = static_cast<core::u32>(mLinesCount - (end - begin));
+}
+
+void Dataset::shuffle(const core::u64 seed) {
+	core::utils::xoshiro256 engine{ seed };
+	engine.shuffle(std::span{ mOrder }.first(mTrainCount));
 }
 
-const Dataset::data_ref_t<Dataset::value_type> &Dataset::get_output(const Type type) const noexcept {
+std::span<const core::u32> Dataset::get_lines(const Type type) const noexcept {
+	if (mSplitStale) return {};
 	if (type == Type::Train) {
-		return mTrainDataOutput;
+		return std::span{ mOrder }.first(mTrainCount);
 	}
-	return mTestDataOutput;
+	return std::span{ mOrder }.subspan(mTrainCount);
+}
+
+Dataset::View Dataset::view(const Type type) const noexcept {
+	return View{ *this, get_lines(type) };
 }
 
 Dataset &Dataset::append(const std::initializer_list<value_type> &input, const std::initializer_list<value_type> &output) noexcept {
-	if ((mInputData.empty() && mOutputData.empty()) || validate(input, output)) {
-		clean_split();
-		mInputData.emplace_back(input);
-		mOutputData.emplace_back(output);
-		++mLinesCount;
-	}
-	return *this;
+	return append_rows(std::span{ std::data(input), input.size() }, std::span{ std::data(output), output.size() }, 1);
 }
 
-Dataset &Dataset::append(std::initializer_list<value_type> &&input, std::initializer_list<value_type> &&output) noexcept {
-	if ((mInputData.empty() && mOutputData.empty()) || validate(input, output)) {
-		clean_split();
-		mInputData.emplace_back(std::move(input));
-		mOutputData.emplace_back(std::move(output));
-		++mLinesCount;
+Dataset &Dataset::append_rows(std::span<const value_type> inputs, std::span<const value_type> outputs,
+		const core::u32 count) noexcept {
+	if (count == 0) [[unlikely]] return *this;
+	if (inputs.size() % count != 0 || outputs.size() % count != 0) [[unlikely]] {
+		spdlog::error("[{}]: {} inputs and {} outputs aren't {} whole lines", class_name.data(),
+			inputs.size(), outputs.size(), count);
+		return *this;
+	}
+
+	const auto input_count{ static_cast<core::u32>(inputs.size() / count) };
+	const auto output_count{ static_cast<core::u32>(outputs.size() / count) };
+	if (empty()) {
+		if (input_count == 0 || output_count == 0) [[unlikely]] {
+			spdlog::error("[{}]: Invalid line size ({} inputs, {} outputs)", class_name.data(), input_count, output_count);
+			return *this;
+		}
+		mInputCount = input_count;
+		mOutputCount = output_count;
+	} else if (!validate(input_count, output_count)) [[unlikely]] {
+		return *this;
 	}
+
+	detach();
+	const auto size{ static_cast<size_t>(line_size()) };
+	const auto required{ mData.size() + count * size };
+	if (mLayout == Layout::RowMajor) {
+		if (required > mData.capacity()) {
+			mData.reserve((std::max)(required, mData.capacity() * 2));
+		}
+		for (size_t line{}; line < count; ++line) {
+			mData.insert(std::end(mData), std::begin(inputs) + line * mInputCount, std::begin(inputs) + (line + 1) * mInputCount);
+			mData.insert(std::end(mData), std::begin(outputs) + line * mOutputCount, std::begin(outputs) + (line + 1) * mOutputCount);
+		}
+	} else {
+		/// Each column grows by `count` values, so the columns are moved from the back to the front
+		mData.resize(required);
+		const auto new_lines_count{ static_cast<size_t>(mLinesCount) + count };
+		for (auto column{ size }; column-- > 0;) {
+			const auto from{ std::begin(mData) + column * mLinesCount };
+			const auto to{ std::begin(mData) + column * new_lines_count };
+			if (to != from) {
+				std::copy_backward(from, from + mLinesCount, to + mLinesCount);
+			}
+
+			const auto is_input{ column < mInputCount };
+			const auto source{ is_input ? inputs : outputs };
+			const auto stride{ is_input ? mInputCount : mOutputCount };
+			const auto offset{ is_input ? column : column - mInputCount };
+			for (size_t line{}; line < count; ++line) {
+				*(to + mLinesCount + line) = source[line * stride + offset];
+			}
+		}
+	}
+	mLinesCount += count;
 	return *this;
 }
 
 void Dataset::erase(const core::u32 line) {
-	if (line >= mInputData.size()) [[unlikely]] return;
+	if (line >= mLinesCount) [[unlikely]] return;
+
+	detach();
+	mSplitStale = true;
+	const auto size{ static_cast<size_t>(line_size()) };
+	if (mLayout == Layout::RowMajor) {
+		const auto from{ std::begin(mData) + line * size };
+		mData.erase(from, from + size);
+	} else {
+		/// Each column shrinks by one value, so the columns are shifted from the front to the back
+		auto to{ std::begin(mData) };
+		for (size_t column{}; column < size; ++column) {
+			const auto from{ std::begin(mData) + column * mLinesCount };
+			/// The head of the first column is already in place
+			to = (to == from) ? to + line : std::copy(from, from + line, to);
+			to = std::copy(from + line + 1, from + mLinesCount, to);
+		}
+		mData.resize(mData.size() - size);
+	}
+	if (--mLinesCount == 0) {
+		mInputCount = mOutputCount = 0;
+	}
+}
 
-	clean_split();
-	mInputData.erase(mInputData.begin() + line);
-	mOutputData.erase(mOutputData.begin() + line);
-	--mLinesCount;
+void Dataset::swap_erase(const core::u32 line) {
+	if (line >= mLinesCount) [[unlikely]] return;
+
+	detach();
+	mSplitStale = true;
+	const auto size{ static_cast<size_t>(line_size()) };
+	const auto last{ mLinesCount - 1 };
+	if (mLayout == Layout::RowMajor) {
+		if (line != last) {
+			std::copy_n(std::begin(mData) + last * size, size, std::begin(mData) + line * size);
+		}
+		mData.resize(mData.size() - size);
+	} else {
+		/// Each column loses its last value, so the columns are shifted from the front to the back
+		auto to{ std::begin(mData) };
+		for (size_t column{}; column < size; ++column) {
+			const auto from{ std::begin(mData) + column * mLinesCount };
+			*(from + line) = *(from + last);
+			to = (to == from) ? to + last : std::copy(from, from + last, to);
+		}
+		mData.resize(mData.size() - size);
+	}
+
+	/// Give the memory back once the most of it isn't used
+	if (mData.size() < mData.capacity() / 4) {
+		mData.shrink_to_fit();
+	}
+	if (--mLinesCount == 0) {
+		mInputCount = mOutputCount = 0;
+	}
 }
 
-std::vector<core::byte> Dataset::raw() const {
-	if (mLinesCount == 0) [[unlikely]] return {};
-	if (mInputData.empty() || mOutputData.empty()) [[unlikely]] return {};
+void Dataset::standardize(const FeatureStatistics &statistics) {
+	if (statistics.get_input_count() != mInputCount || statistics.get_output_count() != mOutputCount) [[unlikely]] {
+		spdlog::error("[{}]: The statistics are computed for the different line size", class_name.data());
+		return;
+	}
 
-	const auto input_count{ get_input_count() };
-	const auto output_count{ get_output_count() };
-	if (input_count == 0 || output_count == 0) [[unlikely]] return {};
+	detach();
+	const std::span values{ mData };
+	if (mLayout == Layout::RowMajor) {
+		for (size_t line{}; line < values.size(); line += line_size()) {
+			statistics.standardize_input(values.subspan(line, mInputCount));
+		}
+		return;
+	}
+	for (core::u32 column{}; column < mInputCount; ++column) {
+		const auto mean{ statistics.columns()[column].mean };
+		const auto inverse_deviation{ statistics.inverse_deviation(column) };
+		for (auto &value : values.subspan(static_cast<size_t>(column) * mLinesCount, mLinesCount)) {
+			value = (value - mean) * inverse_deviation;
+		}
+	}
+}
 
-	const auto line_size{ input_count + output_count };
-	const auto data_count{ mLinesCount * line_size };
+void Dataset::set_layout(const Layout layout) {
+	if (mLayout == layout) return;
 
-	std::vector<core::byte> raw_data(data_count * value_size, core::byte{});
-	auto value{ reinterpret_cast<value_type *>(raw_data.data()) };
-	for (core::u32 id{}; id < data_count; ++id) {
-		if (is_input_id(id, line_size, input_count)) {
-			value[id] = mInputData.at(id / line_size).at(id % line_size);
+	detach();
+	if (!mData.empty()) {
+		std::vector<value_type> values(mData.size());
+		if (layout == Layout::ColumnMajor) {
+			transpose(mData, values, mLinesCount, line_size());
 		} else {
-			value[id] = mOutputData.at(id / line_size).at(id % line_size - input_count);
+			transpose(mData, values, line_size(), mLinesCount);
 		}
+		mData = std::move(values);
 	}
+	mLayout = layout;
+}
 
+Dataset::Layout Dataset::layout() const noexcept { return mLayout; }
+
+std::vector<core::byte> Dataset::raw() const {
+	if (empty() || mInputCount == 0 || mOutputCount == 0) [[unlikely]] return {};
+
+	const auto values{ data() };
+	std::vector<core::byte> raw_data(values.size() * value_size, core::byte{});
+	if (mLayout == Layout::RowMajor) {
+		std::memcpy(raw_data.data(), values.data(), raw_data.size());
+	} else {
+		const std::span output{ reinterpret_cast<value_type *>(raw_data.data()), values.size() };
+		transpose(values, output, line_size(), mLinesCount);
+	}
 	return raw_data;
 }
 
-core::u32 Dataset::get_input_count() const noexcept {
-	return mInputData.empty() ? core::u32{} : static_cast<core::u32>(mInputData.front().size());
+core::u32 Dataset::get_input_count() const noexcept { return mInputCount; }
+core::u32 Dataset::get_output_count() const noexcept { return mOutputCount; }
+core::u32 Dataset::line_size() const noexcept { return mInputCount + mOutputCount; }
+core::u32 Dataset::lines_count() const noexcept { return mLinesCount; }
+bool Dataset::empty() const noexcept { return mLinesCount == 0; }
+bool Dataset::is_mapped() const noexcept { return !mMapping.empty(); }
+
+std::span<const Dataset::value_type> Dataset::data() const noexcept {
+	if (!mMapping.empty()) return mMapped;
+	return mData;
 }
-core::u32 Dataset::get_output_count() const noexcept {
-	return mOutputData.empty() ? core::u32{} : static_cast<core::u32>(mOutputData.front().size());
+
+Dataset::line_t Dataset::line(const core::u32 line) const noexcept {
+	if (mLayout != Layout::RowMajor || line >= mLinesCount) [[unlikely]] return {};
+	return data().subspan(static_cast<size_t>(line) * line_size(), line_size());
 }
 
-const Dataset::data_t<Dataset::value_type> &Dataset::get_raw_input() const noexcept {
-	return mInputData;
+Dataset::line_t Dataset::input(const core::u32 line) const noexcept {
+	const auto full{ this->line(line) };
+	return full.empty() ? full : full.first(mInputCount);
 }
-const Dataset::data_t<Dataset::value_type> &Dataset::get_raw_output() const noexcept {
-	return mOutputData;
+
+Dataset::line_t Dataset::output(const core::u32 line) const noexcept {
+	const auto full{ this->line(line) };
+	return full.empty() ? full : full.subspan(mInputCount);
+}
+
+std::span<const Dataset::value_type> Dataset::column(const core::u32 column) const noexcept {
+	if (mLayout != Layout::ColumnMajor || column >= line_size()) [[unlikely]] return {};
+	return data().subspan(static_cast<size_t>(column) * mLinesCount, mLinesCount);
+}
+
+Dataset::value_type Dataset::at(const core::u32 line, const core::u32 column) const noexcept {
+	if (line >= mLinesCount || column >= line_size()) [[unlikely]] return value_type{};
+	if (mLayout == Layout::RowMajor) {
+		return data()[static_cast<size_t>(line) * line_size() + column];
+	}
+	return data()[static_cast<size_t>(column) * mLinesCount + line];
+}
+
+bool Dataset::read_line(const core::u32 line, std::span<value_type> input_data,
+		std::span<value_type> output_data) const noexcept {
+	if (line >= mLinesCount) [[unlikely]] return false;
+	if (input_data.size() < mInputCount || output_data.size() < mOutputCount) [[unlikely]] {
+		spdlog::error("[{}]: The buffers are too small for the line ({} < {} or {} < {})", class_name.data(),
+			input_data.size(), mInputCount, output_data.size(), mOutputCount);
+		return false;
+	}
+
+	if (mLayout == Layout::RowMajor) {
+		std::ranges::copy(input(line), std::begin(input_data));
+		std::ranges::copy(output(line), std::begin(output_data));
+		return true;
+	}
+	for (core::u32 column{}; column < mInputCount; ++column) {
+		input_data[column] = at(line, column);
+	}
+	for (core::u32 column{}; column < mOutputCount; ++column) {
+		output_data[column] = at(line, mInputCount + column);
+	}
+	return true;
 }
 
 void Dataset::clean() {
 	clean_split();
-	mInputData.clear();
-	mOutputData.clear();
-	mLinesCount = 0;
+	mData.clear();
+	mMapping.reset();
+	mMapped = {};
+	mLinesCount = mInputCount = mOutputCount = 0;
 }
 
 void Dataset::clean_split() {
-	mTrainDataInput.clear();
-	mTrainDataOutput.clear();
-	mTestDataInput.clear();
-	mTestDataOutput.clear();
+	mOrder.clear();
+	mTrainCount = 0;
+	mSplitStale = false;
+}
+
+void Dataset::reset_order() {
+	mSplitStale = false;
+	mOrder.resize(mLinesCount);
+	std::iota(std::begin(mOrder), std::end(mOrder), core::u32{});
+	mTrainCount = 0;
+}
+
+std::optional<core::u64> Dataset::class_of(const core::u32 line) const noexcept {
+	if (mOutputCount == 1) {
+		const auto value{ at(line, mInputCount) };
+		if (!std::isfinite(value) || std::trunc(value) != value) [[unlikely]] return std::nullopt;
+		return static_cast<core::u64>(static_cast<core::i64>(value));
+	}
+	core::u32 greatest{};
+	for (core::u32 output{ 1 }; output < mOutputCount; ++output) {
+		if (at(line, mInputCount + output) > at(line, mInputCount + greatest)) {
+			greatest = output;
+		}
+	}
+	return greatest;
 }
 
 #if defined(GOLXZN_DEBUG)
@@ -162,14 +473,11 @@ std::string Dataset::to_string() const {
 		out << "[ out]";
 	}
 	out << "\n";
-	for (core::u32 i{}; i < mInputData.size(); ++i) {
+	for (core::u32 i{}; i < mLinesCount; ++i) {
 		out << std::setw(3) << i << "| ";
-		for (const auto &v : mInputData.at(i)) {
-			out << '[' << std::setw(4) << v << ']';
-		}
-		out << " ";
-		for (const auto &v : mOutputData.at(i)) {
-			out << '[' << std::setw(4) << v << ']';
+		for (core::u32 column{}; column < line_size(); ++column) {
+			if (column == mInputCount) out << " ";
+			out << '[' << std::setw(4) << at(i, column) << ']';
 		}
 		out << '\n';
 	}
@@ -199,54 +507,107 @@ std::string Dataset::dump() const {
 #endif // GOLXZN_DEBUG
 
 
-void Dataset::load_from_raw_data(const core::byte *raw_data, const core::u32 data_length,
+void Dataset::map_from(core::resources::resource_view mapping, const size_t offset,
+		const core::u32 input_count, const core::u32 output_count) {
+	if (mapping.empty()) [[unlikely]] return;
+	if (input_count == 0 || output_count == 0) [[unlikely]] {
+		spdlog::error("[{}]: Invalid line size ({} inputs, {} outputs)", class_name.data(), input_count, output_count);
+		return;
+	}
+
+	const auto bytes{ mapping.data().subspan(std::min(offset, mapping.size())) };
+	const auto line_size{ static_cast<size_t>(input_count) + output_count };
+	const auto lines_count{ bytes.size() / value_size / line_size };
+	if (lines_count > (std::numeric_limits<core::u32>::max)()) [[unlikely]] {
+		spdlog::error("[{}]: Too many lines ({})", class_name.data(), lines_count);
+		return;
+	}
+
+	clean();
+	mLayout = Layout::RowMajor;
+	mInputCount = input_count;
+	mOutputCount = output_count;
+	mLinesCount = static_cast<core::u32>(lines_count);
+
+	/// The values cannot be viewed in place, e.g. the file is in the pack built without the alignment
+	if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(value_type) != 0) [[unlikely]] {
+		spdlog::debug("[{}]: The mapped data is misaligned, so it's copied", class_name.data());
+		mData.resize(lines_count * line_size);
+		std::memcpy(mData.data(), bytes.data(), mData.size() * value_size);
+		return;
+	}
+
+	mapping.advise(core::resources::mapped_file::access_pattern::sequential, offset);
+	mMapped = { reinterpret_cast<const value_type *>(bytes.data()), lines_count * line_size };
+	mMapping = std::move(mapping);
+}
+
+void Dataset::detach() {
+	if (mMapping.empty()) return;
+
+	mData.assign(std::begin(mMapped), std::end(mMapped));
+	mMapped = {};
+	mMapping.reset();
+}
+
+void Dataset::load_from_raw_data(const core::byte *raw_data, const size_t data_length,
 		const core::u32 input_count, const core::u32 output_count) {
 	if (data_length == 0 || raw_data == nullptr) [[unlikely]] return;
+	if (input_count == 0 || output_count == 0) [[unlikely]] {
+		spdlog::error("[{}]: Invalid line size ({} inputs, {} outputs)", class_name.data(), input_count, output_count);
+		return;
+	}
 
-	const auto data_count{ data_length / value_size };
-	const auto line_size{ input_count + output_count };
-	mLinesCount = data_count / line_size;
-	mInputData.resize(mLinesCount);
-	mOutputData.resize(mLinesCount);
-
-	const auto output_divider{ output_count * line_size };
-	const auto value{ reinterpret_cast<const value_type *>(raw_data) };
-	for(core::u32 id{}; id < data_count; ++id) {
-		if (is_input_id(id, line_size, input_count)) {
-			auto &input = mInputData.at(id / line_size);
-			if (input.capacity() == 0) {
-				input.reserve(input_count);
-			}
-			input.emplace_back(value[id]);
-		} else {
-			auto &output = mOutputData.at(id / line_size);
-			if (output.capacity() == 0) {
-				output.reserve(output_count);
-			}
-			output.emplace_back(value[id]);
-		}
+	const auto line_size{ static_cast<size_t>(input_count) + output_count };
+	const auto lines_count{ data_length / value_size / line_size };
+	if (lines_count > (std::numeric_limits<core::u32>::max)()) [[unlikely]] {
+		spdlog::error("[{}]: Too many lines ({})", class_name.data(), lines_count);
+		return;
+	}
+
+	mInputCount = input_count;
+	mOutputCount = output_count;
+	mLinesCount = static_cast<core::u32>(lines_count);
+	mData.resize(lines_count * line_size);
+	std::memcpy(mData.data(), raw_data, mData.size() * value_size);
+
+	if (mLayout == Layout::ColumnMajor) {
+		mLayout = Layout::RowMajor;
+		set_layout(Layout::ColumnMajor);
 	}
 }
 
-bool Dataset::validate(const std::initializer_list<value_type> &input_data,
-		const std::initializer_list<value_type> &output_data) const noexcept {
+bool Dataset::validate(const core::u32 input_count, const core::u32 output_count) const noexcept {
 
-	if (const auto count{ get_input_count() }; count != input_data.size()) [[unlikely]] {
+	if (const auto count{ get_input_count() }; count != input_count) [[unlikely]] {
 		spdlog::error("[{}]: Cannot append input data with different size ({} != {})",
-			class_name.data(), count, input_data.size());
+			class_name.data(), count, input_count);
 		return false;
 	}
 
-	if (const auto count{ get_output_count() }; count != output_data.size()) [[unlikely]] {
+	if (const auto count{ get_output_count() }; count != output_count) [[unlikely]] {
 		spdlog::error("[{}]: Cannot append output data with different size ({} != {})",
-			class_name.data(), count, output_data.size());
+			class_name.data(), count, output_count);
 		return false;
 	}
 	return true;
 }
 
-bool Dataset::is_input_id(const core::u32 id, const core::u32 line_size, const core::u32 input_count) noexcept {
-	return (id % line_size) < input_count;
+void Dataset::transpose(std::span<const value_type> from, std::span<value_type> to,
+		const size_t rows, const size_t columns) noexcept {
+	/// Blocked to keep both the read and the write sides in the cache
+	static constexpr size_t block{ 32 };
+	for (size_t row_block{}; row_block < rows; row_block += block) {
+		const auto row_end{ std::min(rows, row_block + block) };
+		for (size_t column_block{}; column_block < columns; column_block += block) {
+			const auto column_end{ std::min(columns, column_block + block) };
+			for (auto row{ row_block }; row < row_end; ++row) {
+				for (auto column{ column_block }; column < column_end; ++column) {
+					to[column * rows + row] = from[row * columns + column];
+				}
+			}
+		}
+	}
 }
 
 std::array<Dataset::count_value_type, 3> Dataset::get_input_and_output_count(const std::vector<core::byte> &data) {
@@ -261,4 +622,3 @@ std::array<Dataset::count_value_type, 3> Dataset::get_input_and_output_count(con
 }
 
 } // namespace golxzn::neural
-
@@ -0,0 +1,164 @@
+#include <thread>
+#include <charconv>
+#include <core/common>
+#include <core/resources/mapped_file.hpp>
+
+#include "neural/dataset.hpp"
+#include "neural/dataset_converter.hpp"
+
+namespace golxzn::neural {
+
+std::vector<core::byte> DatasetConverter::convert(const std::string_view text) {
+	return convert(text, Settings{});
+}
+
+std::vector<core::byte> DatasetConverter::convert(const std::string_view text, const Settings &settings) {
+	auto body{ text };
+	if (settings.skip_first_line) {
+		const auto end{ body.find('\n') };
+		body = end == body.npos ? std::string_view{} : body.substr(end + 1);
+	}
+	if (body.empty()) [[unlikely]] return {};
+
+	const auto threads_count{ settings.threads_count != 0
+		? settings.threads_count
+		: (std::max)(std::thread::hardware_concurrency(), 1u) };
+	const auto parts{ cut(body, threads_count) };
+
+	std::vector<Chunk> chunks(parts.size());
+	{
+		std::vector<std::jthread> workers;
+		workers.reserve(parts.size());
+		for (size_t i{}; i < parts.size(); ++i) {
+			workers.emplace_back([&, i] { chunks[i] = parse(parts[i], settings.separator); });
+		}
+	}
+
+	size_t columns_count{};
+	size_t values_count{};
+	size_t line_offset{ settings.skip_first_line ? 1u : 0u }; ///< the physical lines of the previous chunks
+	for (const auto &chunk : chunks) {
+		if (chunk.error_line != 0) [[unlikely]] {
+			spdlog::error("[{}]: Cannot parse the line {}", class_name.data(), line_offset + chunk.error_line);
+			return {};
+		}
+		if (chunk.lines_count != 0) {
+			if (columns_count == 0) columns_count = chunk.columns_count;
+			if (chunk.columns_count != columns_count) [[unlikely]] {
+				spdlog::error("[{}]: The lines near the line {} have {} columns instead of {}",
+					class_name.data(), line_offset + 1, chunk.columns_count, columns_count);
+				return {};
+			}
+			values_count += chunk.values.size();
+		}
+		line_offset += chunk.physical_lines;
+	}
+	if (columns_count <= settings.output_count || settings.output_count == 0) [[unlikely]] {
+		spdlog::error("[{}]: Cannot take {} outputs from {} columns", class_name.data(),
+			settings.output_count, columns_count);
+		return {};
+	}
+
+	const size_t header_size{ settings.write_counts ? Dataset::count_value_size * 2 : 0 };
+	std::vector<core::byte> result(header_size + values_count * Dataset::value_size);
+	if (settings.write_counts) {
+		const std::array<Dataset::count_value_type, 2> counts{
+			static_cast<Dataset::count_value_type>(columns_count - settings.output_count),
+			settings.output_count
+		};
+		std::memcpy(result.data(), counts.data(), header_size);
+	}
+
+	auto destination{ result.data() + header_size };
+	for (const auto &chunk : chunks) {
+		const auto size{ chunk.values.size() * Dataset::value_size };
+		if (size == 0) continue;
+		std::memcpy(destination, chunk.values.data(), size);
+		destination += size;
+	}
+	return result;
+}
+
+bool DatasetConverter::convert(const core::fs::path &source, const core::fs::path &output, const Settings &settings) {
+	const core::resources::mapped_file file{ source };
+	if (!file.is_open()) [[unlikely]] return false;
+	file.advise(core::resources::mapped_file::access_pattern::sequential);
+
+	const auto bytes{ file.data() };
+	const auto result{ convert(std::string_view{ reinterpret_cast<const char *>(bytes.data()), bytes.size() }, settings) };
+	if (result.empty()) [[unlikely]] return false;
+
+	if (const auto parent{ output.parent_path() }; !parent.empty() && !core::fs::exists(parent)) {
+		core::fs::create_directories(parent);
+	}
+	core::fs::ofstream stream{ output, std::ios::binary | std::ios::trunc };
+	if (!stream.write(reinterpret_cast<const char *>(result.data()), static_cast<std::streamsize>(result.size()))) [[unlikely]] {
+		spdlog::error("[{}]: Cannot write '{}'", class_name.data(), output.string());
+		return false;
+	}
+	return true;
+}
+
+char DatasetConverter::separator_of(const core::fs::path &source) noexcept {
+	return source.extension() == ".csv" ? ',' : ' ';
+}
+
+std::vector<std::string_view> DatasetConverter::cut(const std::string_view text, const size_t count) {
+	std::vector<std::string_view> parts;
+	parts.reserve(count);
+
+	const auto step{ std::max<size_t>(text.size() / std::max<size_t>(count, 1), 1) };
+	size_t begin{};
+	while (begin < text.size()) {
+		auto end{ parts.size() + 1 == count ? text.size() : std::min(begin + step, text.size()) };
+		if (end < text.size()) {
+			end = text.find('\n', end);
+			end = end == text.npos ? text.size() : end + 1;
+		}
+		parts.emplace_back(text.substr(begin, end - begin));
+		begin = end;
+	}
+	return parts;
+}
+
+DatasetConverter::Chunk DatasetConverter::parse(const std::string_view text, const char separator) {
+	static constexpr auto is_blank{ [](const char c) { return c == ' ' || c == '\t' || c == '\r'; } };
+
+	Chunk chunk;
+	chunk.values.reserve(text.size() / 4);
+
+	auto current{ text.data() };
+	const auto end{ text.data() + text.size() };
+	while (current < end) {
+		const auto line_end{ std::find(current, end, '\n') };
+		++chunk.physical_lines;
+		size_t columns{};
+		while (current < line_end) {
+			while (current < line_end && (is_blank(*current) || *current == separator)) ++current;
+			if (current == line_end) break;
+
+			if (*current == '+') ++current;
+			core::f32 value{};
+			const auto [next, error]{ std::from_chars(current, line_end, value) };
+			if (error != std::errc{} || (next < line_end && !is_blank(*next) && *next != separator)) [[unlikely]] {
+				chunk.error_line = chunk.physical_lines;
+				return chunk;
+			}
+			chunk.values.push_back(value);
+			++columns;
+			current = next;
+		}
+		current = line_end + (line_end < end ? 1 : 0);
+		if (columns == 0) continue; // empty line
+
+		if (chunk.columns_count == 0) chunk.columns_count = columns;
+		if (columns != chunk.columns_count) [[unlikely]] {
+			chunk.error_line = chunk.physical_lines;
+			return chunk;
+		}
+		++chunk.lines_count;
+	}
+	return chunk;
+}
+
+} // namespace golxzn::neural
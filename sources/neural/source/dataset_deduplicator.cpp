@@ -0,0 +1,142 @@
+#include <bit>
+#include <thread>
+#include <cstring>
+#include <core/common>
+#include <core/utils/hash.hpp>
+
+#include "neural/dataset.hpp"
+#include "neural/dataset_deduplicator.hpp"
+
+namespace golxzn::neural {
+
+namespace {
+
+/** @brief The line in any layout. The column-major one is gathered into the buffer */
+std::span<const Dataset::value_type> row_of(const Dataset &dataset, const core::u32 line,
+		std::vector<Dataset::value_type> &buffer) noexcept {
+	if (dataset.layout() == Dataset::Layout::RowMajor) return dataset.line(line);
+
+	const std::span values{ buffer };
+	dataset.read_line(line, values.first(dataset.get_input_count()), values.subspan(dataset.get_input_count()));
+	return values;
+}
+
+bool same_rows(std::span<const Dataset::value_type> lhs, std::span<const Dataset::value_type> rhs) noexcept {
+	return std::memcmp(lhs.data(), rhs.data(), lhs.size_bytes()) == 0;
+}
+
+template<class Job>
+void run_workers(const core::u32 workers_count, Job &&job) {
+	std::vector<std::jthread> workers;
+	workers.reserve(workers_count);
+	for (core::u32 worker{}; worker < workers_count; ++worker) {
+		workers.emplace_back(job, worker);
+	}
+}
+
+} // anonymous namespace
+
+core::u32 DatasetDeduplicator::Result::duplicates_count() const noexcept {
+	core::u64 total{};
+	for (const auto multiplicity : multiplicities) total += multiplicity;
+	return static_cast<core::u32>(total - unique.size());
+}
+
+std::vector<core::f32> DatasetDeduplicator::Result::weights() const {
+	return { std::begin(multiplicities), std::end(multiplicities) };
+}
+
+DatasetDeduplicator::Result DatasetDeduplicator::find(const Dataset &dataset, const core::u32 threads_count) {
+	if (dataset.empty()) [[unlikely]] return {};
+
+	const auto lines_count{ dataset.lines_count() };
+	const auto workers_count{ std::min<core::u32>(lines_count,
+		threads_count != 0 ? threads_count : (std::max)(std::thread::hardware_concurrency(), 1u)) };
+
+	std::vector<core::u64> hashes(lines_count);
+	run_workers(workers_count, [&](const core::u32 worker) {
+		std::vector<Dataset::value_type> buffer(dataset.line_size());
+		const auto begin{ static_cast<core::u32>(static_cast<core::u64>(lines_count) * worker / workers_count) };
+		const auto end{ static_cast<core::u32>(static_cast<core::u64>(lines_count) * (worker + 1) / workers_count) };
+		for (auto line{ begin }; line < end; ++line) {
+			hashes[line] = core::utils::hash::values(row_of(dataset, line, buffer));
+		}
+	});
+
+	/// Counting sort of the lines by their shard, so each worker walks only its own bucket.
+	/// The sort is stable, so every bucket is in the ascending order of the lines
+	const auto shard_of{ [workers_count](const core::u64 hash) { return static_cast<core::u32>((hash >> 32) % workers_count); } };
+	std::vector<core::u32> bucket_offsets(workers_count + 1);
+	for (const auto hash : hashes) ++bucket_offsets[shard_of(hash) + 1];
+	for (core::u32 shard{}; shard < workers_count; ++shard) bucket_offsets[shard + 1] += bucket_offsets[shard];
+
+	std::vector<core::u32> sharded_lines(lines_count);
+	{
+		auto positions{ bucket_offsets };
+		for (core::u32 line{}; line < lines_count; ++line) {
+			sharded_lines[positions[shard_of(hashes[line])]++] = line;
+		}
+	}
+
+	/// The first occurrence of each line. Every bucket is scanned in the ascending order,
+	/// so the first occurrence is always the smallest index
+	static constexpr core::u32 empty_slot{ core::invalid_id<core::u32>() };
+	std::vector<core::u32> representatives(lines_count);
+	run_workers(workers_count, [&](const core::u32 worker) {
+		const std::span bucket{ std::span{ sharded_lines }.subspan(bucket_offsets[worker],
+			bucket_offsets[worker + 1] - bucket_offsets[worker]) };
+		const auto capacity{ std::bit_ceil(bucket.size() * 2 + 1) };
+		std::vector<core::u32> slots(capacity, empty_slot);
+
+		std::vector<Dataset::value_type> lhs_buffer(dataset.line_size());
+		std::vector<Dataset::value_type> rhs_buffer(dataset.line_size());
+		for (const auto line : bucket) {
+			const auto hash{ hashes[line] };
+			representatives[line] = line;
+			for (auto slot{ hash & (capacity - 1) };; slot = (slot + 1) & (capacity - 1)) {
+				const auto other{ slots[slot] };
+				if (other == empty_slot) {
+					slots[slot] = line;
+					break;
+				}
+				if (hashes[other] == hash && same_rows(row_of(dataset, other, lhs_buffer),
+						row_of(dataset, line, rhs_buffer))) {
+					representatives[line] = other;
+					break;
+				}
+			}
+		}
+	});
+
+	Result result;
+	std::vector<core::u32> unique_index(lines_count);
+	for (core::u32 line{}; line < lines_count; ++line) {
+		if (representatives[line] == line) {
+			unique_index[line] = static_cast<core::u32>(result.unique.size());
+			result.unique.push_back(line);
+			result.multiplicities.push_back(1);
+		} else {
+			++result.multiplicities[unique_index[representatives[line]]];
+		}
+	}
+	return result;
+}
+
+DatasetDeduplicator::Result DatasetDeduplicator::deduplicate(Dataset &dataset, const core::u32 threads_count) {
+	auto result{ find(dataset, threads_count) };
+	if (result.unique.size() == dataset.lines_count()) return result;
+
+	const auto input_count{ dataset.get_input_count() };
+	const auto output_count{ dataset.get_output_count() };
+	const auto line_size{ static_cast<size_t>(dataset.line_size()) };
+
+	std::vector<Dataset::value_type> data(result.unique.size() * line_size);
+	for (size_t i{}; i < result.unique.size(); ++i) {
+		const std::span line{ data.data() + i * line_size, line_size };
+		dataset.read_line(result.unique[i], line.first(input_count), line.subspan(input_count));
+	}
+	dataset = Dataset{ std::move(data), input_count, output_count, dataset.layout() };
+	return result;
+}
+
+} // namespace golxzn::neural
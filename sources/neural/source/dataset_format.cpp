@@ -0,0 +1,323 @@
+#include <bit>
+#include <cmath>
+#include <core/common>
+#include <core/resources/manager.hpp>
+
+#include "neural/dataset_format.hpp"
+
+namespace golxzn::neural {
+
+namespace {
+
+template<class T>
+void write_value(std::span<core::byte> output, size_t &offset, const T value) noexcept {
+	std::memcpy(output.data() + offset, &value, sizeof(T));
+	offset += sizeof(T);
+}
+
+template<class T>
+T read_value(std::span<const core::byte> input, size_t &offset) noexcept {
+	T value{};
+	std::memcpy(&value, input.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+/// IEEE half conversions on the bit patterns. Only the subnormal, overflow and NaN values branch
+
+core::u16 to_half(const float value) noexcept {
+	constexpr core::u32 f32_infinity{ 255u << 23 };
+	constexpr core::u32 f16_max{ (127u + 16u) << 23 };
+	constexpr core::u32 denormal_magic{ ((127u - 15u) + (23u - 10u) + 1u) << 23 };
+
+	auto bits{ std::bit_cast<core::u32>(value) };
+	const auto sign{ bits & 0x80000000u };
+	bits ^= sign;
+
+	core::u32 result{};
+	if (bits >= f16_max) {
+		result = bits > f32_infinity ? 0x7E00u : 0x7C00u; // NaN or Inf
+	} else if (bits < (113u << 23)) {
+		const auto denormal{ std::bit_cast<float>(bits) + std::bit_cast<float>(denormal_magic) };
+		result = std::bit_cast<core::u32>(denormal) - denormal_magic;
+	} else {
+		const auto odd{ (bits >> 13) & 1u };
+		bits += ((15u - 127u) << 23) + 0xFFFu + odd; // round to nearest even
+		result = bits >> 13;
+	}
+	return static_cast<core::u16>(result | (sign >> 16));
+}
+
+float from_half(const core::u16 value) noexcept {
+	constexpr core::u32 shifted_exponent{ 0x7C00u << 13 };
+	constexpr auto magic{ std::bit_cast<float>(113u << 23) };
+
+	auto bits{ (static_cast<core::u32>(value) & 0x7FFFu) << 13 };
+	const auto exponent{ shifted_exponent & bits };
+	bits += (127u - 15u) << 23;
+	if (exponent == shifted_exponent) {
+		bits += (128u - 16u) << 23; // Inf or NaN
+	} else if (exponent == 0) {
+		bits += 1u << 23; // denormal
+		bits = std::bit_cast<core::u32>(std::bit_cast<float>(bits) - magic);
+	}
+	return std::bit_cast<float>(bits | ((static_cast<core::u32>(value) & 0x8000u) << 16));
+}
+
+core::u16 to_bfloat(const float value) noexcept {
+	const auto bits{ std::bit_cast<core::u32>(value) };
+	if (std::isnan(value)) return static_cast<core::u16>((bits >> 16) | 0x40u);
+	return static_cast<core::u16>((bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16); // round to nearest even
+}
+
+float from_bfloat(const core::u16 value) noexcept {
+	return std::bit_cast<float>(static_cast<core::u32>(value) << 16);
+}
+
+template<class T, class Convert>
+void convert_to(std::span<const core::f32> from, std::span<core::byte> to, Convert &&convert) noexcept {
+	for (size_t i{}; i < from.size(); ++i) {
+		const T value{ convert(from[i], i) };
+		std::memcpy(to.data() + i * sizeof(T), &value, sizeof(T));
+	}
+}
+
+template<class T, class Convert>
+void convert_from(std::span<const core::byte> from, std::span<core::f32> to, Convert &&convert) noexcept {
+	for (size_t i{}; i < to.size(); ++i) {
+		T value;
+		std::memcpy(&value, from.data() + i * sizeof(T), sizeof(T));
+		to[i] = convert(value);
+	}
+}
+
+} // anonymous namespace
+
+bool DatasetFormat::Header::is_identity() const noexcept {
+	return std::ranges::all_of(scales, [](const auto scale) { return scale == 1.0; })
+		&& std::ranges::all_of(offsets, [](const auto offset) { return offset == 0.0; });
+}
+
+size_t DatasetFormat::element_size(const ElementType type) noexcept {
+	switch (type) {
+		case ElementType::F64: return sizeof(double);
+		case ElementType::F32: return sizeof(float);
+		case ElementType::F16: [[fallthrough]];
+		case ElementType::BF16: return sizeof(core::u16);
+		case ElementType::U8: return sizeof(core::u8);
+	}
+	return 0;
+}
+
+bool DatasetFormat::is_formatted(std::span<const core::byte> content) noexcept {
+	if (content.size() < sizeof(magic)) return false;
+	size_t offset{};
+	return read_value<core::u32>(content, offset) == magic;
+}
+
+std::optional<DatasetFormat::Header> DatasetFormat::read_header(std::span<const core::byte> content) {
+	return read_header(content, content.size());
+}
+
+std::optional<DatasetFormat::Header> DatasetFormat::read_header(std::span<const core::byte> head,
+		const core::u64 content_size) {
+	if (head.size() < header_size || !is_formatted(head)) [[unlikely]] {
+		spdlog::error("[{}]: The content isn't the formatted dataset", class_name.data());
+		return std::nullopt;
+	}
+
+	Header header;
+	size_t offset{ sizeof(magic) };
+	header.version = read_value<core::u16>(head, offset);
+	header.type = static_cast<ElementType>(read_value<core::u8>(head, offset));
+	offset += sizeof(core::u8); // reserved
+	header.input_count = read_value<core::u32>(head, offset);
+	header.output_count = read_value<core::u32>(head, offset);
+	header.lines_count = read_value<core::u64>(head, offset);
+	header.alignment = read_value<core::u32>(head, offset);
+	header.data_offset = read_value<core::u32>(head, offset);
+
+	if (header.version != version) [[unlikely]] {
+		spdlog::error("[{}]: Unsupported version {}", class_name.data(), header.version);
+		return std::nullopt;
+	}
+	if (element_size(header.type) == 0 || header.input_count == 0 || header.output_count == 0) [[unlikely]] {
+		spdlog::error("[{}]: The header is corrupted", class_name.data());
+		return std::nullopt;
+	}
+
+	const auto columns{ static_cast<core::u64>(header.input_count) + header.output_count };
+	if (columns > (std::numeric_limits<core::u32>::max)()) [[unlikely]] {
+		spdlog::error("[{}]: The header is corrupted", class_name.data());
+		return std::nullopt;
+	}
+
+	/// The sizes come from the untrusted header, so the lines count is checked by the division
+	const auto tables_end{ header_size + columns * 2 * sizeof(core::f32) };
+	const auto line_bytes{ columns * element_size(header.type) };
+	if (header.data_offset < tables_end || head.size() < tables_end || content_size < header.data_offset
+			|| header.lines_count > (content_size - header.data_offset) / line_bytes) [[unlikely]] {
+		spdlog::error("[{}]: The content is truncated", class_name.data());
+		return std::nullopt;
+	}
+
+	header.scales.resize(columns);
+	header.offsets.resize(columns);
+	for (auto &scale : header.scales) scale = read_value<core::f32>(head, offset);
+	for (auto &value : header.offsets) value = read_value<core::f32>(head, offset);
+	return header;
+}
+
+std::optional<DatasetFormat::Header> DatasetFormat::read_header(std::istream &stream, const core::u64 content_size) {
+	std::vector<core::byte> head(header_size);
+	if (!stream.read(reinterpret_cast<char *>(head.data()), header_size)) [[unlikely]] {
+		spdlog::error("[{}]: Cannot read the header", class_name.data());
+		return std::nullopt;
+	}
+
+	size_t offset{ sizeof(magic) + sizeof(core::u16) + sizeof(core::u8) * 2 };
+	const auto input_count{ read_value<core::u32>(head, offset) };
+	const auto output_count{ read_value<core::u32>(head, offset) };
+	const auto tables_end{ header_size + (static_cast<core::u64>(input_count) + output_count) * 2 * sizeof(core::f32) };
+	if (tables_end > content_size) [[unlikely]] {
+		spdlog::error("[{}]: The content is truncated", class_name.data());
+		return std::nullopt;
+	}
+
+	head.resize(tables_end);
+	const auto tables_size{ static_cast<std::streamsize>(tables_end - header_size) };
+	if (!stream.read(reinterpret_cast<char *>(head.data() + header_size), tables_size)) [[unlikely]] {
+		spdlog::error("[{}]: Cannot read the header", class_name.data());
+		return std::nullopt;
+	}
+	return read_header(head, content_size);
+}
+
+std::vector<core::byte> DatasetFormat::encode(const Dataset &dataset, const ElementType type, const core::u32 alignment) {
+	if (dataset.empty()) [[unlikely]] return {};
+	if (element_size(type) == 0 || alignment < sizeof(core::f32) || !std::has_single_bit(alignment)) [[unlikely]] {
+		spdlog::error("[{}]: Invalid element type or alignment {}", class_name.data(), alignment);
+		return {};
+	}
+
+	Header header;
+	header.type = type;
+	header.input_count = dataset.get_input_count();
+	header.output_count = dataset.get_output_count();
+	header.lines_count = dataset.lines_count();
+	header.alignment = alignment;
+
+	const auto columns{ static_cast<size_t>(header.line_size()) };
+	const auto unaligned{ header_size + columns * 2 * sizeof(core::f32) };
+	header.data_offset = static_cast<core::u32>((unaligned + alignment - 1) / alignment * alignment);
+	header.scales.assign(columns, 1.0);
+	header.offsets.assign(columns, 0.0);
+
+	if (type == ElementType::U8) {
+		for (core::u32 column{}; column < columns; ++column) {
+			auto minimum{ (std::numeric_limits<core::f32>::max)() };
+			auto maximum{ std::numeric_limits<core::f32>::lowest() };
+			for (core::u32 line{}; line < dataset.lines_count(); ++line) {
+				const auto value{ dataset.at(line, column) };
+				minimum = std::min(minimum, value);
+				maximum = (std::max)(maximum, value);
+			}
+			header.offsets[column] = minimum;
+			header.scales[column] = maximum > minimum ? (maximum - minimum) / 255.0 : 1.0;
+		}
+	}
+
+	std::vector<core::byte> result(header.data_offset + header.lines_count * columns * element_size(type));
+	size_t offset{};
+	write_value(std::span{ result }, offset, magic);
+	write_value(std::span{ result }, offset, header.version);
+	write_value(std::span{ result }, offset, static_cast<core::u8>(header.type));
+	write_value(std::span{ result }, offset, core::u8{});
+	write_value(std::span{ result }, offset, header.input_count);
+	write_value(std::span{ result }, offset, header.output_count);
+	write_value(std::span{ result }, offset, header.lines_count);
+	write_value(std::span{ result }, offset, header.alignment);
+	write_value(std::span{ result }, offset, header.data_offset);
+	for (const auto scale : header.scales) write_value(std::span{ result }, offset, scale);
+	for (const auto value : header.offsets) write_value(std::span{ result }, offset, value);
+
+	std::vector<core::byte> transposed;
+	std::span<const core::f32> values{ dataset.data() };
+	if (dataset.layout() != Dataset::Layout::RowMajor) {
+		transposed = dataset.raw();
+		values = { reinterpret_cast<const core::f32 *>(transposed.data()), dataset.data().size() };
+	}
+	encode_values(values, std::span{ result }.subspan(header.data_offset), header);
+	return result;
+}
+
+Dataset DatasetFormat::decode(std::span<const core::byte> content, const Dataset::Layout layout) {
+	const auto header{ read_header(content) };
+	if (!header.has_value()) [[unlikely]] return {};
+
+	std::vector<core::f32> values(header->lines_count * header->line_size());
+	decode_values(content.subspan(header->data_offset), values, *header);
+	return Dataset{ std::move(values), header->input_count, header->output_count, layout };
+}
+
+bool DatasetFormat::save(const Dataset &dataset, const std::string_view path, const ElementType type) {
+	const auto content{ encode(dataset, type) };
+	if (content.empty()) [[unlikely]] return false;
+	return core::resources::manager::save_binary(path, content);
+}
+
+void DatasetFormat::encode_values(std::span<const core::f32> from, std::span<core::byte> to, const Header &header) {
+	const auto columns{ static_cast<size_t>(header.line_size()) };
+	switch (header.type) {
+		case ElementType::F64:
+			std::memcpy(to.data(), from.data(), from.size_bytes());
+			break;
+		case ElementType::F32:
+			convert_to<float>(from, to, [](const auto value, size_t) { return static_cast<float>(value); });
+			break;
+		case ElementType::F16:
+			convert_to<core::u16>(from, to, [](const auto value, size_t) { return to_half(static_cast<float>(value)); });
+			break;
+		case ElementType::BF16:
+			convert_to<core::u16>(from, to, [](const auto value, size_t) { return to_bfloat(static_cast<float>(value)); });
+			break;
+		case ElementType::U8:
+			convert_to<core::u8>(from, to, [&](const auto value, const size_t i) {
+				const auto column{ i % columns };
+				const auto quantized{ std::round((value - header.offsets[column]) / header.scales[column]) };
+				return static_cast<core::u8>(std::clamp(quantized, 0.0, 255.0));
+			});
+			break;
+	}
+}
+
+void DatasetFormat::decode_values(std::span<const core::byte> from, std::span<core::f32> to, const Header &header) {
+	switch (header.type) {
+		case ElementType::F64:
+			std::memcpy(to.data(), from.data(), to.size_bytes());
+			break;
+		case ElementType::F32:
+			convert_from<float>(from, to, [](const float value) { return static_cast<core::f32>(value); });
+			break;
+		case ElementType::F16:
+			convert_from<core::u16>(from, to, [](const core::u16 value) { return static_cast<core::f32>(from_half(value)); });
+			break;
+		case ElementType::BF16:
+			convert_from<core::u16>(from, to, [](const core::u16 value) { return static_cast<core::f32>(from_bfloat(value)); });
+			break;
+		case ElementType::U8:
+			convert_from<core::u8>(from, to, [](const core::u8 value) { return static_cast<core::f32>(value); });
+			break;
+	}
+	if (header.is_identity()) return;
+
+	/// The scale and offset pass is separate, so the conversion loops above don't index the columns
+	const auto columns{ static_cast<size_t>(header.line_size()) };
+	for (size_t line{}; line < to.size(); line += columns) {
+		for (size_t column{}; column < columns; ++column) {
+			to[line + column] = to[line + column] * header.scales[column] + header.offsets[column];
+		}
+	}
+}
+
+} // namespace golxzn::neural
@@ -0,0 +1,159 @@
+#include <core/common>
+#include <core/resources/manager.hpp>
+
+#include "neural/dataset_stream.hpp"
+
+namespace golxzn::neural {
+
+DatasetStream::DatasetStream(const std::string_view file) : DatasetStream{ file, Settings{} } {}
+
+DatasetStream::DatasetStream(const std::string_view file, const Settings &settings) : mSettings{ settings } {
+	open(file, true);
+}
+
+DatasetStream::DatasetStream(const std::string_view file, const core::u32 input_count, const core::u32 output_count,
+		const Settings &settings) : mSettings{ settings }, mInputCount{ input_count }, mOutputCount{ output_count } {
+	open(file, false);
+}
+
+DatasetStream::~DatasetStream() {
+	mRing.stop();
+}
+
+DatasetStream::Chunk DatasetStream::next() {
+	/// The ring isn't started when the file couldn't be opened
+	if (!is_open()) [[unlikely]] return {};
+
+	const auto filled{ mRing.take() };
+	if (!filled.has_value()) return {};
+
+	const auto [buffer, lines_count]{ *filled };
+	Chunk chunk;
+	chunk.mData = std::span{ mBuffers[buffer] }.first(static_cast<size_t>(lines_count) * (mInputCount + mOutputCount));
+	chunk.mLinesCount = lines_count;
+	chunk.mInputCount = mInputCount;
+	chunk.mOutputCount = mOutputCount;
+	return chunk;
+}
+
+void DatasetStream::restart() {
+	if (!is_open()) [[unlikely]] return;
+
+	mRing.stop();
+	mRing.start(static_cast<core::u32>(mBuffers.size()), [this] { read(); });
+}
+
+bool DatasetStream::is_open() const noexcept { return !mBuffers.empty(); }
+core::u32 DatasetStream::get_input_count() const noexcept { return mInputCount; }
+core::u32 DatasetStream::get_output_count() const noexcept { return mOutputCount; }
+const DatasetStream::Settings &DatasetStream::settings() const noexcept { return mSettings; }
+
+DatasetStream::Metrics DatasetStream::metrics() const {
+	std::lock_guard lock{ mMetricsMutex };
+	auto metrics{ mMetrics };
+	metrics.stall_time = mRing.metrics().stall_time;
+	if (const auto seconds{ std::chrono::duration<core::f64>(metrics.read_time).count() }; seconds > 0.0) {
+		metrics.bytes_per_second = static_cast<core::f64>(metrics.bytes_read) / seconds;
+	}
+	return metrics;
+}
+
+void DatasetStream::open(const std::string_view file, const bool has_header) {
+	mPath = core::resources::manager::resolve(file);
+	if (mPath.empty()) [[unlikely]] return;
+
+	std::error_code error;
+	mEnd = core::fs::file_size(mPath, error);
+	if (error) [[unlikely]] {
+		spdlog::error("[{}]: Cannot get the size of '{}': {}", class_name.data(), file, error.message());
+		return;
+	}
+
+	if (has_header) {
+		core::fs::ifstream stream{ mPath, std::ios::binary };
+		std::array<Dataset::count_value_type, 2> counts{};
+		if (!stream.read(reinterpret_cast<char *>(counts.data()), sizeof(counts))) [[unlikely]] {
+			spdlog::error("[{}]: Cannot read the header of '{}'", class_name.data(), file);
+			return;
+		}
+
+		if (DatasetFormat::is_formatted({ reinterpret_cast<const core::byte *>(counts.data()), sizeof(counts) })) {
+			stream.seekg(0);
+			mFormat = DatasetFormat::read_header(stream, mEnd);
+			if (!mFormat.has_value()) [[unlikely]] {
+				spdlog::error("[{}]: Cannot read the header of '{}'", class_name.data(), file);
+				return;
+			}
+			mOffset = mFormat->data_offset;
+			mEnd = mOffset + mFormat->lines_count * mFormat->line_size() * DatasetFormat::element_size(mFormat->type);
+			mInputCount = mFormat->input_count;
+			mOutputCount = mFormat->output_count;
+		} else {
+			mOffset = sizeof(counts);
+			mInputCount = counts[0];
+			mOutputCount = counts[1];
+		}
+	}
+	if (mInputCount == 0 || mOutputCount == 0) [[unlikely]] {
+		spdlog::error("[{}]: Invalid line size ({} inputs, {} outputs)", class_name.data(), mInputCount, mOutputCount);
+		return;
+	}
+
+	mSettings.chunk_lines = (std::max)(mSettings.chunk_lines, core::u32{ 1 });
+	mSettings.buffers_count = (std::max)(mSettings.buffers_count, core::u32{ 2 });
+	const auto chunk_size{ static_cast<size_t>(mSettings.chunk_lines) * (mInputCount + mOutputCount) };
+	if (mFormat.has_value() && (mFormat->type != DatasetFormat::ElementType::F64 || !mFormat->is_identity())) {
+		mStaging.resize(chunk_size * DatasetFormat::element_size(mFormat->type));
+	}
+	mBuffers.assign(mSettings.buffers_count, std::vector<value_type>(chunk_size));
+	mRing.start(mSettings.buffers_count, [this] { read(); });
+}
+
+void DatasetStream::read() {
+	core::fs::ifstream stream{ mPath, std::ios::binary };
+	stream.seekg(static_cast<std::streamoff>(mOffset));
+
+	const auto line_size{ static_cast<size_t>(mInputCount + mOutputCount) };
+	const auto element_size{ mFormat.has_value() ? DatasetFormat::element_size(mFormat->type) : Dataset::value_size };
+	const auto line_bytes{ line_size * element_size };
+	size_t position{ mOffset };
+	for (;;) {
+		const auto acquired{ mRing.acquire() };
+		if (!acquired.has_value()) break;
+
+		const auto buffer{ *acquired };
+		const auto read_start{ clock::now() };
+		auto &values{ mBuffers[buffer] };
+		/// The formatted file may have the trailing bytes after its lines, so they're never read
+		const auto wanted{ (std::min)(values.size() * element_size, mEnd - position) };
+		auto *target{ mStaging.empty() ? reinterpret_cast<char *>(values.data()) : reinterpret_cast<char *>(mStaging.data()) };
+		stream.read(target, static_cast<std::streamsize>(wanted));
+		const auto bytes{ static_cast<size_t>(stream.gcount()) };
+		position += bytes;
+		const auto lines_count{ static_cast<core::u32>(bytes / line_bytes) };
+		if (!mStaging.empty()) {
+			DatasetFormat::decode_values(mStaging, std::span{ values }.first(lines_count * line_size), *mFormat);
+		}
+		if (mSettings.statistics != nullptr) {
+			for (size_t line{}; line < lines_count; ++line) {
+				mSettings.statistics->standardize_input(std::span{ values }.subspan(line * (mInputCount + mOutputCount), mInputCount));
+			}
+		}
+		const auto read_time{ std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - read_start) };
+
+		{
+			std::lock_guard lock{ mMetricsMutex };
+			mMetrics.bytes_read += bytes;
+			mMetrics.read_time += read_time;
+			mMetrics.chunks += lines_count != 0;
+		}
+		if (lines_count == 0) {
+			mRing.release(buffer);
+			break;
+		}
+		mRing.publish(buffer, lines_count);
+		if (!stream || position >= mEnd) break; // the tail of the file was read
+	}
+}
+
+} // namespace golxzn::neural
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <core/utils/random.hpp>
+#include <core/common>
+#include <core/utils/hash.hpp>
+
+#include "neural/embedding.hpp"
+
+namespace golxzn::neural {
+
+Embedding::Embedding(const core::u32 vocabulary_size, const core::u32 dimension)
+	: mVocabularySize{ vocabulary_size }, mDimension{ dimension } {
+	if (mVocabularySize == 0 || mDimension == 0) [[unlikely]] {
+		spdlog::error("[{}]: Cannot create the embedding of {}x{} size",
+			class_name.data(), mVocabularySize, mDimension);
+		mVocabularySize = mDimension = 0;
+		return;
+	}
+	mWeights.resize(static_cast<size_t>(mVocabularySize) * mDimension, constants::default_weight);
+}
+
+core::u32 Embedding::vocabulary_size() const noexcept { return mVocabularySize; }
+core::u32 Embedding::dimension() const noexcept { return mDimension; }
+
+std::span<const Embedding::value_type> Embedding::row(const index_type index) const noexcept {
+	if (index >= mVocabularySize) [[unlikely]] return {};
+	return std::span{ mWeights }.subspan(static_cast<size_t>(index) * mDimension, mDimension);
+}
+
+std::span<Embedding::value_type> Embedding::row(const index_type index) noexcept {
+	if (index >= mVocabularySize) [[unlikely]] return {};
+	return std::span{ mWeights }.subspan(static_cast<size_t>(index) * mDimension, mDimension);
+}
+
+std::vector<Embedding::value_type> Embedding::lookup(const input_t &input) const {
+	std::vector<value_type> output(mDimension, value_type{});
+	lookup(input, output);
+	return output;
+}
+
+void Embedding::lookup(const input_t &input, std::span<value_type> output) const noexcept {
+	if (output.size() != mDimension) [[unlikely]] {
+		spdlog::error("[{}]: Invalid output size ({} != {})", class_name.data(), output.size(), mDimension);
+		return;
+	}
+
+	std::ranges::fill(output, value_type{});
+	for (const auto &feature : input) {
+		if (!is_valid(feature)) [[unlikely]] continue;
+
+		const auto weights{ row(feature.index) };
+		std::transform(std::begin(weights), std::end(weights), std::begin(output), std::begin(output),
+			[value = feature.value](const auto weight, const auto accumulated) {
+				return accumulated + weight * value;
+			}
+		);
+	}
+}
+
+void Embedding::update(const input_t &input, std::span<const value_type> gradient,
+		const core::f32 rate) noexcept {
+	if (gradient.size() != mDimension) [[unlikely]] {
+		spdlog::error("[{}]: Invalid gradient size ({} != {})", class_name.data(), gradient.size(), mDimension);
+		return;
+	}
+
+	for (const auto &feature : input) {
+		if (!is_valid(feature)) [[unlikely]] continue;
+
+		auto weights{ row(feature.index) };
+		const auto factor{ rate * feature.value };
+		std::transform(std::begin(weights), std::end(weights), std::begin(gradient), std::begin(weights),
+			[factor](const auto weight, const auto grad) { return weight - factor * grad; }
+		);
+	}
+}
+
+void Embedding::randomize(const core::f32 min, const core::f32 max) {
+	using namespace core::utils;
+	std::ranges::generate(mWeights, [min, max] { return random::range<core::f32>(min, max); });
+}
+
+void Embedding::randomize(const core::f32 range) {
+	const auto abs_range{ std::abs(range) };
+	randomize(-abs_range, abs_range);
+}
+
+Embedding::index_type Embedding::index_of(const std::string_view token) const noexcept {
+	if (mVocabularySize == 0) [[unlikely]] return index_type{};
+	/// std::hash is implementation-defined, so the trained rows would move with the toolchain
+	const auto hash{ core::utils::hash::bytes({ reinterpret_cast<const core::byte *>(token.data()), token.size() }) };
+	return static_cast<index_type>(hash % mVocabularySize);
+}
+
+Embedding::input_t Embedding::make_input(const std::string_view text) const {
+	std::vector<index_type> indices;
+	for (std::string_view::size_type beg{ text.find_first_not_of(token_separators) };
+			beg != std::string_view::npos;) {
+		const auto end{ text.find_first_of(token_separators, beg) };
+		indices.push_back(index_of(text.substr(beg, end - beg)));
+		beg = text.find_first_not_of(token_separators, end);
+	}
+	std::ranges::sort(indices);
+
+	input_t input;
+	for (const auto index : indices) {
+		if (!input.empty() && input.back().index == index) {
+			input.back().value += value_type{ 1 };
+		} else {
+			input.emplace_back(Feature{ index, value_type{ 1 } });
+		}
+	}
+	return input;
+}
+
+bool Embedding::is_valid(const Feature &feature) const noexcept {
+	if (feature.index < mVocabularySize) [[likely]] return true;
+
+	spdlog::warn("[{}]: Feature index {} is out of vocabulary ({})",
+		class_name.data(), feature.index, mVocabularySize);
+	return false;
+}
+
+} // namespace golxzn::neural
@@ -0,0 +1,220 @@
+#include <thread>
+#include <core/common>
+#include <core/resources/manager.hpp>
+
+#include "neural/dataset.hpp"
+#include "neural/feature_statistics.hpp"
+
+namespace golxzn::neural {
+
+namespace {
+
+template<class T>
+void write_value(std::vector<core::byte> &output, const T value) {
+	const auto bytes{ reinterpret_cast<const core::byte *>(&value) };
+	output.insert(std::end(output), bytes, bytes + sizeof(T));
+}
+
+template<class T>
+T read_value(std::span<const core::byte> input, size_t &offset) noexcept {
+	T value{};
+	std::memcpy(&value, input.data() + offset, sizeof(T));
+	offset += sizeof(T);
+	return value;
+}
+
+} // anonymous namespace
+
+void FeatureStatistics::Column::update(const value_type value) noexcept {
+	++count;
+	const auto delta{ value - mean };
+	mean += delta / static_cast<value_type>(count);
+	m2 += delta * (value - mean);
+	min = std::min(min, value);
+	max = (std::max)(max, value);
+}
+
+void FeatureStatistics::Column::merge(const Column &other) noexcept {
+	if (other.count == 0) return;
+	if (count == 0) {
+		*this = other;
+		return;
+	}
+
+	const auto total{ static_cast<value_type>(count + other.count) };
+	const auto delta{ other.mean - mean };
+	mean += delta * static_cast<value_type>(other.count) / total;
+	m2 += other.m2 + delta * delta * static_cast<value_type>(count) * static_cast<value_type>(other.count) / total;
+	count += other.count;
+	min = std::min(min, other.min);
+	max = (std::max)(max, other.max);
+}
+
+FeatureStatistics::value_type FeatureStatistics::Column::variance() const noexcept {
+	return count > 1 ? m2 / static_cast<value_type>(count) : value_type{};
+}
+
+FeatureStatistics::value_type FeatureStatistics::Column::deviation() const noexcept {
+	return std::sqrt(variance());
+}
+
+FeatureStatistics::FeatureStatistics(const core::u32 input_count, const core::u32 output_count)
+	: mInputCount{ input_count }, mOutputCount{ output_count }, mColumns(input_count + output_count) {
+	refresh();
+}
+
+FeatureStatistics FeatureStatistics::compute(const Dataset &dataset, const core::u32 threads_count) {
+	FeatureStatistics result{ dataset.get_input_count(), dataset.get_output_count() };
+	if (dataset.empty()) [[unlikely]] return result;
+
+	const auto lines_count{ dataset.lines_count() };
+	const auto workers_count{ std::min<core::u32>(lines_count,
+		threads_count != 0 ? threads_count : (std::max)(std::thread::hardware_concurrency(), 1u)) };
+
+	std::vector<FeatureStatistics> partials(workers_count, result);
+	{
+		std::vector<std::jthread> workers;
+		for (core::u32 worker{}; worker < workers_count; ++worker) {
+			workers.emplace_back([&, worker] {
+				auto &columns{ partials[worker].mColumns };
+				const auto begin{ static_cast<core::u32>(static_cast<core::u64>(lines_count) * worker / workers_count) };
+				const auto end{ static_cast<core::u32>(static_cast<core::u64>(lines_count) * (worker + 1) / workers_count) };
+
+				if (dataset.layout() == Dataset::Layout::ColumnMajor) {
+					for (core::u32 column{}; column < columns.size(); ++column) {
+						for (const auto value : dataset.column(column).subspan(begin, end - begin)) {
+							columns[column].update(value);
+						}
+					}
+					return;
+				}
+				for (auto line{ begin }; line < end; ++line) {
+					const auto values{ dataset.line(line) };
+					for (size_t column{}; column < columns.size(); ++column) {
+						columns[column].update(values[column]);
+					}
+				}
+			});
+		}
+	}
+
+	for (const auto &partial : partials) {
+		result.merge(partial);
+	}
+	return result;
+}
+
+void FeatureStatistics::update(std::span<const value_type> lines) {
+	if (mColumns.empty()) [[unlikely]] return;
+
+	for (size_t i{}; i + mColumns.size() <= lines.size(); i += mColumns.size()) {
+		for (size_t column{}; column < mColumns.size(); ++column) {
+			mColumns[column].update(lines[i + column]);
+		}
+	}
+	refresh();
+}
+
+void FeatureStatistics::merge(const FeatureStatistics &other) {
+	if (other.mColumns.size() != mColumns.size()) [[unlikely]] {
+		spdlog::error("[{}]: Cannot merge {} columns into {}", class_name.data(), other.mColumns.size(), mColumns.size());
+		return;
+	}
+	for (size_t column{}; column < mColumns.size(); ++column) {
+		mColumns[column].merge(other.mColumns[column]);
+	}
+	refresh();
+}
+
+bool FeatureStatistics::empty() const noexcept {
+	return mColumns.empty() || mColumns.front().count == 0;
+}
+
+core::u32 FeatureStatistics::get_input_count() const noexcept { return mInputCount; }
+core::u32 FeatureStatistics::get_output_count() const noexcept { return mOutputCount; }
+const std::vector<FeatureStatistics::Column> &FeatureStatistics::columns() const noexcept { return mColumns; }
+
+FeatureStatistics::value_type FeatureStatistics::inverse_deviation(const core::u32 column) const noexcept {
+	return column < mInverseDeviations.size() ? mInverseDeviations[column] : value_type{ 1 };
+}
+
+void FeatureStatistics::standardize(std::span<value_type> values, const core::u32 first_column) const noexcept {
+	const auto count{ std::min<size_t>(values.size(), mColumns.size() - std::min<size_t>(first_column, mColumns.size())) };
+	if (count == 0) return;
+
+	const auto *means{ mMeans.data() + first_column };
+	const auto *inverses{ mInverseDeviations.data() + first_column };
+	for (size_t i{}; i < count; ++i) {
+		values[i] = (values[i] - means[i]) * inverses[i];
+	}
+}
+
+void FeatureStatistics::standardize_input(std::span<value_type> input) const noexcept {
+	standardize(input.first(std::min<size_t>(input.size(), mInputCount)));
+}
+
+std::vector<core::byte> FeatureStatistics::serialize() const {
+	std::vector<core::byte> result;
+	result.reserve(4 * sizeof(core::u32) + mColumns.size() * sizeof(Column));
+	write_value(result, magic);
+	write_value(result, version);
+	write_value(result, mInputCount);
+	write_value(result, mOutputCount);
+	for (const auto &column : mColumns) {
+		write_value(result, column.count);
+		write_value(result, column.mean);
+		write_value(result, column.m2);
+		write_value(result, column.min);
+		write_value(result, column.max);
+	}
+	return result;
+}
+
+FeatureStatistics FeatureStatistics::deserialize(std::span<const core::byte> content) {
+	static constexpr size_t header_size{ 4 * sizeof(core::u32) };
+	static constexpr size_t column_size{ sizeof(core::u64) + 4 * sizeof(value_type) };
+	if (content.size() < header_size) [[unlikely]] return {};
+
+	size_t offset{};
+	const auto file_magic{ read_value<core::u32>(content, offset) };
+	const auto file_version{ read_value<core::u32>(content, offset) };
+	const auto input_count{ read_value<core::u32>(content, offset) };
+	const auto output_count{ read_value<core::u32>(content, offset) };
+	if (file_magic != magic || file_version != version
+			|| content.size() != header_size + (static_cast<size_t>(input_count) + output_count) * column_size) [[unlikely]] {
+		spdlog::error("[{}]: The content isn't the feature statistics", class_name.data());
+		return {};
+	}
+
+	FeatureStatistics result{ input_count, output_count };
+	for (auto &column : result.mColumns) {
+		column.count = read_value<core::u64>(content, offset);
+		column.mean = read_value<value_type>(content, offset);
+		column.m2 = read_value<value_type>(content, offset);
+		column.min = read_value<value_type>(content, offset);
+		column.max = read_value<value_type>(content, offset);
+	}
+	result.refresh();
+	return result;
+}
+
+bool FeatureStatistics::save(const std::string_view path) const {
+	if (mColumns.empty()) [[unlikely]] return false;
+	return core::resources::manager::save_binary(path, serialize());
+}
+
+FeatureStatistics FeatureStatistics::load(const std::string_view path) {
+	return deserialize(core::resources::manager::load_binary(path));
+}
+
+void FeatureStatistics::refresh() {
+	mMeans.resize(mColumns.size());
+	mInverseDeviations.resize(mColumns.size());
+	for (size_t column{}; column < mColumns.size(); ++column) {
+		const auto deviation{ mColumns[column].deviation() };
+		mMeans[column] = mColumns[column].mean;
+		mInverseDeviations[column] = deviation > value_type{} ? value_type{ 1 } / deviation : value_type{ 1 };
+	}
+}
+
+} // namespace golxzn::neural
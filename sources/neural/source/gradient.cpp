@@ -0,0 +1,108 @@
+#include <core/common>
+
+#include "neural/gradient.hpp"
+#include "neural/network.hpp"
+#include "neural/neuron.hpp"
+
+namespace golxzn::neural {
+
+Gradient::Gradient(const Network &network) {
+	reshape(network);
+}
+
+void Gradient::reshape(const Network &network) {
+	std::vector<size_t> neuron_offsets{ 0 };
+	std::vector<size_t> layer_neurons{ 0 };
+
+	for (const auto &layer : network.layers()) {
+		if (layer != nullptr) [[likely]] {
+			for (const auto &neuron : layer->neurons()) {
+				neuron_offsets.push_back(neuron_offsets.back() + neuron->previous_edges_count());
+			}
+		}
+		layer_neurons.push_back(neuron_offsets.size() - 1);
+	}
+
+	if (neuron_offsets == mNeuronOffsets && layer_neurons == mLayerNeurons) return;
+
+	mNeuronOffsets = std::move(neuron_offsets);
+	mLayerNeurons = std::move(layer_neurons);
+	mValues.assign(mNeuronOffsets.back(), value_type{});
+	mOutput.assign(neurons_count(layers_count() - 1), value_type{});
+}
+
+void Gradient::fill(const value_type value) noexcept {
+	std::ranges::fill(mValues, value);
+}
+
+bool Gradient::empty() const noexcept { return mValues.empty(); }
+size_t Gradient::size() const noexcept { return mValues.size(); }
+
+core::u32 Gradient::layers_count() const noexcept {
+	return static_cast<core::u32>(mLayerNeurons.size() - 1);
+}
+
+core::u32 Gradient::neurons_count(const core::u32 layer) const noexcept {
+	if (layer >= layers_count()) [[unlikely]] return 0;
+	return static_cast<core::u32>(mLayerNeurons[layer + 1] - mLayerNeurons[layer]);
+}
+
+std::span<Gradient::value_type> Gradient::values() noexcept { return mValues; }
+std::span<const Gradient::value_type> Gradient::values() const noexcept { return mValues; }
+
+std::span<Gradient::value_type> Gradient::layer(const core::u32 layer) noexcept {
+	if (layer >= layers_count()) [[unlikely]] return {};
+	const auto beg{ mNeuronOffsets[mLayerNeurons[layer]] };
+	const auto end{ mNeuronOffsets[mLayerNeurons[layer + 1]] };
+	return std::span{ mValues }.subspan(beg, end - beg);
+}
+
+std::span<const Gradient::value_type> Gradient::layer(const core::u32 layer) const noexcept {
+	return const_cast<Gradient *>(this)->layer(layer);
+}
+
+std::span<Gradient::value_type> Gradient::output() noexcept { return mOutput; }
+std::span<const Gradient::value_type> Gradient::output() const noexcept { return mOutput; }
+
+std::span<Gradient::value_type> Gradient::neuron(const core::u32 layer, const core::u32 neuron) noexcept {
+	if (neuron >= neurons_count(layer)) [[unlikely]] return {};
+	const auto index{ mLayerNeurons[layer] + neuron };
+	const auto beg{ mNeuronOffsets[index] };
+	return std::span{ mValues }.subspan(beg, mNeuronOffsets[index + 1] - beg);
+}
+
+std::span<const Gradient::value_type> Gradient::neuron(const core::u32 layer, const core::u32 neuron) const noexcept {
+	return const_cast<Gradient *>(this)->neuron(layer, neuron);
+}
+
+Gradient::three_vec_t<Gradient::value_type> Gradient::to_nested() const {
+	three_vec_t<value_type> nested(layers_count());
+	for (core::u32 layer_id{}; layer_id < layers_count(); ++layer_id) {
+		auto &layer_values{ nested[layer_id] };
+		layer_values.reserve(neurons_count(layer_id));
+		for (core::u32 neuron_id{}; neuron_id < neurons_count(layer_id); ++neuron_id) {
+			const auto values{ neuron(layer_id, neuron_id) };
+			layer_values.emplace_back(std::begin(values), std::end(values));
+		}
+	}
+	return nested;
+}
+
+bool Gradient::assign(const three_vec_t<value_type> &nested) noexcept {
+	if (nested.size() != layers_count()) [[unlikely]] return false;
+
+	for (core::u32 layer_id{}; layer_id < layers_count(); ++layer_id) {
+		const auto &layer_values{ nested[layer_id] };
+		if (layer_values.size() != neurons_count(layer_id)) [[unlikely]] return false;
+
+		for (core::u32 neuron_id{}; neuron_id < neurons_count(layer_id); ++neuron_id) {
+			const auto &values{ layer_values[neuron_id] };
+			auto target{ neuron(layer_id, neuron_id) };
+			if (values.size() != target.size()) [[unlikely]] return false;
+			std::ranges::copy(values, std::begin(target));
+		}
+	}
+	return true;
+}
+
+} // namespace golxzn::neural
@@ -0,0 +1,130 @@
+#include <cmath>
+#include <core/common>
+#include <core/resources/manager.hpp>
+
+#include "neural/header_exporter.hpp"
+#include "neural/shared_weights.hpp"
+#include "neural/activation/linear_function.hpp"
+#include "neural/activation/relu_function.hpp"
+#include "neural/activation/sigmoid_function.hpp"
+#include "neural/activation/softmax_function.hpp"
+
+namespace golxzn::neural {
+
+HeaderExporter::Model HeaderExporter::describe(const Network &network, const std::string_view name) {
+	const auto weights{ SharedWeights::snapshot(network) };
+	if (weights == nullptr) [[unlikely]] return {};
+
+	Model model{ .name = std::string{ name }, .topology = weights->topology(), .activations = {}, .weights = {} };
+	/// The neuron without the activation passes its value through, as the linear one does
+	std::ranges::transform(weights->activations(), std::back_inserter(model.activations),
+		[](const auto &activation) {
+			return activation != nullptr ? activation->get_type() : std::string{ activation::LinearFunction::type };
+		});
+	model.weights.assign(std::begin(weights->weights()), std::end(weights->weights()));
+	return model;
+}
+
+std::string HeaderExporter::write(const Model &model) {
+	if (!validate(model)) [[unlikely]] return {};
+
+	const auto join{ [](const auto &values, auto &&format) {
+		std::string result;
+		for (const auto &value : values) {
+			if (!result.empty()) result += ", ";
+			result += format(value);
+		}
+		return result;
+	} };
+
+	std::vector<core::u32> offsets;
+	for (size_t layer{}, offset{}; layer + 1 < model.topology.size(); ++layer) {
+		offsets.emplace_back(static_cast<core::u32>(offset));
+		offset += (model.topology[layer] + 1) * model.topology[layer + 1];
+	}
+
+	std::string weights;
+	static constexpr size_t values_per_line{ 8 };
+	for (size_t i{}; i < model.weights.size(); ++i) {
+		weights += (i % values_per_line == 0) ? "\n\t\t" : " ";
+		weights += fmt::format("{},", model.weights[i]);
+	}
+
+	std::string result;
+	result += "// Generated by golxzn::neural::HeaderExporter. Do not edit.\n";
+	result += "#pragma once\n\n";
+	result += "#include <array>\n#include <string_view>\n#include <core/aliases.hpp>\n\n";
+	result += fmt::format("namespace {} {{\n\n", models_namespace);
+	result += fmt::format("struct {} {{\n", model.name);
+	result += fmt::format("\tstatic constexpr std::array<core::u32, {}> topology{{ {} }};\n",
+		model.topology.size(), join(model.topology, [](auto v) { return std::to_string(v); }));
+	result += fmt::format("\tstatic constexpr std::array<std::string_view, {}> activations{{ {} }};\n",
+		model.activations.size(), join(model.activations, [](const auto &v) { return fmt::format("\"{}\"", v); }));
+	result += fmt::format("\tstatic constexpr std::array<core::u32, {}> offsets{{ {} }};\n",
+		offsets.size(), join(offsets, [](auto v) { return std::to_string(v); }));
+	result += fmt::format("\talignas({}) static constexpr std::array<core::f32, {}> weights{{{}\n\t}};\n",
+		weights_alignment, model.weights.size(), weights);
+	result += "};\n\n";
+	result += fmt::format("}} // namespace {}\n", models_namespace);
+	return result;
+}
+
+std::string HeaderExporter::write(const Network &network, const std::string_view name) {
+	return write(describe(network, name));
+}
+
+bool HeaderExporter::save(const Network &network, const std::string_view name, const std::string_view path) {
+	const auto header{ write(network, name) };
+	if (header.empty()) [[unlikely]] return false;
+	return core::resources::manager::save_string(path, header);
+}
+
+bool HeaderExporter::validate(const Model &model) {
+	if (!is_identifier(model.name)) [[unlikely]] {
+		spdlog::error("[{}]: The model name '{}' isn't a valid identifier", class_name, model.name);
+		return false;
+	}
+	if (model.topology.size() < 2 || model.activations.size() != model.topology.size()) [[unlikely]] {
+		spdlog::error("[{}]: The model '{}' has invalid topology", class_name, model.name);
+		return false;
+	}
+	if (std::ranges::find(model.topology, core::u32{}) != std::end(model.topology)) [[unlikely]] {
+		spdlog::error("[{}]: The model '{}' has an empty layer", class_name, model.name);
+		return false;
+	}
+	/// StaticNetwork dispatches only these activations at compile time
+	static constexpr std::array<std::string_view, 4> supported{
+		activation::SigmoidFunction::type, activation::ReLUFunction::type,
+		activation::LinearFunction::type, activation::SoftmaxFunction::type,
+	};
+	for (const auto &activation : model.activations) {
+		if (std::ranges::find(supported, activation) == std::end(supported)) [[unlikely]] {
+			spdlog::error("[{}]: The model '{}' has unsupported activation '{}'", class_name, model.name, activation);
+			return false;
+		}
+	}
+
+	size_t expected{};
+	for (size_t layer{}; layer + 1 < model.topology.size(); ++layer) {
+		expected += (model.topology[layer] + 1) * model.topology[layer + 1];
+	}
+	if (model.weights.size() != expected) [[unlikely]] {
+		spdlog::error("[{}]: The model '{}' has {} weights instead of {}",
+			class_name, model.name, model.weights.size(), expected);
+		return false;
+	}
+	if (!std::ranges::all_of(model.weights, [](const auto weight) { return std::isfinite(weight); })) [[unlikely]] {
+		spdlog::error("[{}]: The model '{}' has non-finite weights", class_name, model.name);
+		return false;
+	}
+	return true;
+}
+
+bool HeaderExporter::is_identifier(const std::string_view name) noexcept {
+	if (name.empty() || std::isdigit(static_cast<unsigned char>(name.front()))) return false;
+	return std::ranges::all_of(name, [](const char c) {
+		return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+	});
+}
+
+} // namespace golxzn::neural
@@ -0,0 +1,120 @@
+#include <core/common>
+
+#include "neural/inference_context.hpp"
+#include "neural/activation/softmax_function.hpp"
+
+namespace golxzn::neural {
+
+InferenceContext::InferenceContext(core::sptr<const SharedWeights> weights)
+	: mWeights{ std::move(weights) } {
+	if (mWeights == nullptr || !mWeights->valid()) [[unlikely]] {
+		spdlog::error("[{}]: The weights are invalid", class_name);
+		mWeights = nullptr;
+		return;
+	}
+	mCurrent.resize(mWeights->max_width());
+	mNext.resize(mWeights->max_width());
+}
+
+const core::sptr<const SharedWeights> &InferenceContext::weights() const noexcept { return mWeights; }
+
+std::span<const core::f32> InferenceContext::predict(std::span<const core::f32> input) {
+	if (mWeights == nullptr) [[unlikely]] return {};
+	if (input.size() != mWeights->input_count()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid input size ({} != {})", class_name, input.size(), mWeights->input_count());
+		return {};
+	}
+
+	const auto &topology{ mWeights->topology() };
+	std::ranges::copy(input, std::begin(mCurrent));
+
+	for (core::u32 layer{}; layer + 1 < mWeights->layers_count(); ++layer) {
+		const size_t in_count{ topology[layer] };
+		const size_t out_count{ topology[layer + 1] };
+		const auto block{ mWeights->block(layer) };
+		const auto bias{ block.subspan(in_count * out_count, out_count) };
+
+		const auto next{ std::span{ mNext }.first(out_count) };
+		std::ranges::copy(bias, std::begin(next));
+		for (size_t i{}; i < in_count; ++i) {
+			const auto value{ mCurrent[i] };
+			const auto row{ block.subspan(i * out_count, out_count) };
+			for (size_t j{}; j < out_count; ++j) {
+				next[j] += value * row[j];
+			}
+		}
+
+		activate(layer + 1, next, out_count);
+		std::swap(mCurrent, mNext);
+	}
+
+	return std::span{ mCurrent }.first(mWeights->output_count());
+}
+
+std::span<const core::f32> InferenceContext::predict_batch(std::span<const core::f32> inputs,
+	const core::u32 batch_size) {
+	if (mWeights == nullptr || batch_size == 0) [[unlikely]] return {};
+	if (inputs.size() != static_cast<size_t>(batch_size) * mWeights->input_count()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid batch size ({} != {} x {})",
+			class_name, inputs.size(), batch_size, mWeights->input_count());
+		return {};
+	}
+
+	const auto scratch_size{ static_cast<size_t>(batch_size) * mWeights->max_width() };
+	if (mCurrent.size() < scratch_size) {
+		mCurrent.resize(scratch_size);
+		mNext.resize(scratch_size);
+	}
+
+	const auto &topology{ mWeights->topology() };
+	std::ranges::copy(inputs, std::begin(mCurrent));
+
+	for (core::u32 layer{}; layer + 1 < mWeights->layers_count(); ++layer) {
+		const size_t in_count{ topology[layer] };
+		const size_t out_count{ topology[layer + 1] };
+		const auto block{ mWeights->block(layer) };
+		const auto bias{ block.subspan(in_count * out_count, out_count) };
+
+		const auto next{ std::span{ mNext }.first(batch_size * out_count) };
+		for (size_t sample{}; sample < batch_size; ++sample) {
+			std::ranges::copy(bias, std::begin(next) + sample * out_count);
+		}
+		for (size_t i{}; i < in_count; ++i) {
+			const auto row{ block.subspan(i * out_count, out_count) };
+			for (size_t sample{}; sample < batch_size; ++sample) {
+				const auto value{ mCurrent[sample * in_count + i] };
+				const auto target{ next.subspan(sample * out_count, out_count) };
+				for (size_t j{}; j < out_count; ++j) {
+					target[j] += value * row[j];
+				}
+			}
+		}
+
+		activate(layer + 1, next, out_count);
+		std::swap(mCurrent, mNext);
+	}
+
+	return std::span{ mCurrent }.first(static_cast<size_t>(batch_size) * mWeights->output_count());
+}
+
+void InferenceContext::activate(const core::u32 layer, std::span<core::f32> values, const size_t width) const {
+	const auto &function{ mWeights->activations()[layer] };
+	if (function == nullptr) [[unlikely]] return;
+
+	for (auto &value : values) {
+		value = function->execute(value);
+	}
+	if (function->is(activation::SoftmaxFunction::type)) {
+		for (size_t beg{}; beg < values.size(); beg += width) {
+			const auto sample{ values.subspan(beg, width) };
+			activation::SoftmaxFunction::forward(sample, sample);
+		}
+	}
+}
+
+std::vector<core::f32> InferenceContext::predict(const std::vector<core::f32> &input) {
+	const auto output{ predict(std::span<const core::f32>{ input }) };
+	return { std::begin(output), std::end(output) };
+}
+
+} // namespace golxzn::neural
@@ -1,22 +1,20 @@
 #include <ranges>
+#include <numeric>
 #include <algorithm>
 #include <execution>
-#include <core/constants.hpp>
+#include <core/common>
 
 #include "neural/layer.hpp"
 #include "neural/neuron.hpp"
+#include "neural/activation/softmax_function.hpp"
 
 namespace golxzn::neural {
 
 Layer::Layer(core::id::type id, core::sptr<Network> network, const Settings &settings) noexcept
-	: mID{ id }, mSettings{ settings }, mNetwork{ network } {
-	initialize();
-}
+	: mID{ id }, mSettings{ settings }, mNetwork{ network } {}
 
 Layer::Layer(core::id::type id, core::sptr<Network> network, Settings &&settings) noexcept
-	: mID{ id }, mSettings{ std::move(settings) }, mNetwork{ network } {
-	initialize();
-}
+	: mID{ id }, mSettings{ std::move(settings) }, mNetwork{ network } {}
 
 bool Layer::initialize() {
 	using namespace core::types_literals;
@@ -48,6 +46,12 @@ void Layer::clean() {
 	mNeurons.clear();
 }
 
+void Layer::reset() noexcept {
+	for (auto &neuron : mNeurons) {
+		if (neuron != nullptr) [[likely]] neuron->clean();
+	}
+}
+
 core::id::type Layer::id() const noexcept { return mID; }
 Layer::Type Layer::type() const noexcept { return mSettings.type; }
 core::sptr<Network> Layer::network() const noexcept { return mNetwork.lock(); }
@@ -56,6 +60,9 @@ core::u32 Layer::neuron_count() const noexcept { return static_cast<core::u32>(m
 core::sptr<Neuron> Layer::neuron(core::id::type id) const noexcept { return mNeurons.at(id); }
 core::sptr<activation::IFunction> Layer::activation() const noexcept { return mSettings.activation; }
 bool Layer::is(const Type type) const noexcept { return mSettings.type == type; }
+bool Layer::is_softmax() const noexcept {
+	return mSettings.activation != nullptr && mSettings.activation->is(activation::SoftmaxFunction::type);
+}
 
 Layer::dvec_t<core::f32> Layer::weights() const noexcept {
 	if (mNeurons.empty()) [[unlikely]] return {};
@@ -74,15 +81,62 @@ Layer::dvec_t<core::f32> Layer::back_propagation_shifts(
 
 	if (mNeurons.empty()) [[unlikely]] return {};
 
+	std::vector<core::f32> flat(gradient_size());
+	std::vector<core::f32> output_gradient(is_softmax() ? mNeurons.size() : 0);
+	if (!write_back_propagation_shifts(target_values, flat, output_gradient)) [[unlikely]] return {};
+
 	dvec_t<core::f32> shifts;
 	shifts.reserve(mNeurons.size());
-	std::transform(std::begin(mNeurons), std::end(mNeurons), std::back_inserter(shifts),
-		[&target_values](const auto &neuron) {
-			return neuron->get_back_propagation_shifts(target_values);
+	auto beg{ std::begin(flat) };
+	for (const auto &neuron : mNeurons) {
+		const auto end{ std::next(beg, neuron->previous_edges_count()) };
+		shifts.emplace_back(beg, end);
+		beg = end;
+	}
+	return shifts;
+}
+
+bool Layer::write_back_propagation_shifts(const std::vector<core::f32> &target_values,
+	std::span<core::f32> shifts, std::span<core::f32> output_gradient) const {
+
+	if (shifts.size() != gradient_size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid shifts size ({} != {})", class_name.data(), shifts.size(), gradient_size());
+		return false;
+	}
+	if (shifts.empty()) [[unlikely]] return true;
+
+	if (is(Type::Output) && target_values.size() != mNeurons.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid target size ({} != {})", class_name.data(), target_values.size(), mNeurons.size());
+		return false;
+	}
+
+	const auto softmax{ is(Type::Output) && is_softmax() };
+	if (softmax) {
+		/// The logits are written into the scratch buffer and replaced by the gradient in place
+		if (!raw_output(output_gradient)) [[unlikely]] return false;
+		if (!activation::SoftmaxFunction::cross_entropy(output_gradient, target_values, output_gradient)) [[unlikely]] {
+			return false;
 		}
-	);
+	}
 
-	return shifts;
+	size_t offset{};
+	for (const auto &neuron : mNeurons) {
+		const auto count{ neuron->previous_edges_count() };
+		const auto neuron_shifts{ shifts.subspan(offset, count) };
+		if (softmax) {
+			neuron->write_back_propagation_shifts(output_gradient[neuron->id()], neuron_shifts);
+		} else {
+			neuron->write_back_propagation_shifts(target_values, neuron_shifts);
+		}
+		offset += count;
+	}
+	return true;
+}
+
+core::u32 Layer::gradient_size() const noexcept {
+	return std::accumulate(std::begin(mNeurons), std::end(mNeurons), core::u32{},
+		[](const auto acc, const auto &neuron) { return acc + neuron->previous_edges_count(); }
+	);
 }
 
 Layer::dvec_t<core::sptr<Edge>> Layer::edges() const noexcept {
@@ -98,6 +152,14 @@ Layer::dvec_t<core::sptr<Edge>> Layer::edges() const noexcept {
 }
 
 std::vector<core::f32> Layer::output() const noexcept {
+	auto output_values{ raw_output() };
+	if (is_softmax()) {
+		activation::SoftmaxFunction::forward(output_values, output_values);
+	}
+	return output_values;
+}
+
+std::vector<core::f32> Layer::raw_output() const noexcept {
 	if (mNeurons.empty()) [[unlikely]] return {};
 
 	std::vector<core::f32> output_values;
@@ -109,24 +171,33 @@ std::vector<core::f32> Layer::output() const noexcept {
 	return output_values;
 }
 
+bool Layer::raw_output(std::span<core::f32> output) const noexcept {
+	if (output.size() != mNeurons.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid output size ({} != {})", class_name.data(), output.size(), mNeurons.size());
+		return false;
+	}
+	std::ranges::transform(mNeurons, std::begin(output), [](const auto &neuron) { return neuron->out(); });
+	return true;
+}
+
 void Layer::trigger() {
-	std::for_each(std::execution::par_unseq, std::begin(mNeurons), std::end(mNeurons),
-		[](auto &neuron) {
-			if (neuron == nullptr) [[unlikely]] return;
-			neuron->trigger();
-		}
-	);
+	/// Sequential: the neurons of the layer accumulate into the same neurons of the next one
+	for (auto &neuron : mNeurons) {
+		if (neuron == nullptr) [[unlikely]] continue;
+		neuron->trigger();
+	}
 }
 
 void Layer::set_accumulate(const std::vector<core::f32> &value) noexcept {
-	if (mNeurons.size() != value.size()) [[unlikely]] return;
+	const auto bias_count{ is(Type::Output) ? size_t{} : size_t{ 1 } };
+	if (mNeurons.size() != value.size() + bias_count) [[unlikely]] return;
 
 	std::for_each(std::execution::par_unseq, std::begin(mNeurons), std::end(mNeurons),
 		[&value](auto &neuron) {
-			if (neuron == nullptr) [[unlikely]] return;
+			if (neuron == nullptr || neuron->is_bias()) [[unlikely]] return;
 			const auto id{ neuron->id() };
-			if (id == core::invalid_id<core::u32>()) [[unlikely]] return;
-			neuron->set_accumulate(value.at(id));
+			if (id >= value.size()) [[unlikely]] return;
+			neuron->set_accumulate(value[id]);
 		}
 	);
 }
@@ -134,15 +205,14 @@ void Layer::set_accumulate(const std::vector<core::f32> &value) noexcept {
 void Layer::connect_completely(const core::sptr<Layer> &layer) {
 	if (mNeurons.empty() || layer == nullptr) [[unlikely]] return;
 
-	std::for_each(std::execution::par_unseq, std::begin(mNeurons), std::end(mNeurons),
-		[&](auto &neuron) {
-			if (neuron == nullptr) [[unlikely]] return;
-			std::ranges::for_each(layer->mNeurons, [&neuron](auto &other) {
-				if (other == nullptr || other->is_bias()) [[unlikely]] return;
-				neuron->connect(other);
-			});
-		}
-	);
+	/// Sequential: every neuron appends to the previous edges of the same next neurons
+	for (auto &neuron : mNeurons) {
+		if (neuron == nullptr) [[unlikely]] continue;
+		std::ranges::for_each(layer->mNeurons, [&neuron](auto &other) {
+			if (other == nullptr || other->is_bias()) [[unlikely]] return;
+			neuron->connect(other);
+		});
+	}
 }
 
 void Layer::alter_weights(const dvec_t<core::f32> &weights) {
@@ -157,16 +227,41 @@ void Layer::alter_weights(const dvec_t<core::f32> &weights) {
 	);
 }
 
-void Layer::shift_back_weights(const dvec_t<core::f32> &weights) {
-	if (mNeurons.empty() || weights.empty()) [[unlikely]] return;
+bool Layer::shift_back_weights(const dvec_t<core::f32> &weights) {
+	if (mNeurons.empty() || weights.empty()) [[unlikely]] return false;
+	if (weights.size() != mNeurons.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid shifts count ({} != {})", class_name.data(), weights.size(), mNeurons.size());
+		return false;
+	}
 
-	std::ranges::for_each(std::views::iota(dvec_t<core::f32>::size_type{}, weights.size()),
-		[&weights, this](auto index) {
-			if (auto &neuron{ mNeurons.at(index) }; neuron != nullptr) [[likely]] {
-				neuron->shift_back_weights(weights.at(index));
-			}
+	std::vector<core::f32> flat;
+	flat.reserve(gradient_size());
+	for (size_t index{}; index < weights.size(); ++index) {
+		const auto &neuron_weights{ weights[index] };
+		if (neuron_weights.size() != mNeurons[index]->previous_edges_count()) [[unlikely]] {
+			spdlog::error("[{}]: Invalid shifts size of the neuron {} ({} != {})", class_name.data(),
+				index, neuron_weights.size(), mNeurons[index]->previous_edges_count());
+			return false;
 		}
-	);
+		flat.insert(std::end(flat), std::begin(neuron_weights), std::end(neuron_weights));
+	}
+	return shift_back_weights(std::span<const core::f32>{ flat });
+}
+
+bool Layer::shift_back_weights(std::span<const core::f32> shifts) {
+	if (mNeurons.empty()) [[unlikely]] return false;
+	if (shifts.size() != gradient_size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid shifts size ({} != {})", class_name.data(), shifts.size(), gradient_size());
+		return false;
+	}
+
+	size_t offset{};
+	for (auto &neuron : mNeurons) {
+		const auto count{ neuron->previous_edges_count() };
+		neuron->shift_back_weights(shifts.subspan(offset, count));
+		offset += count;
+	}
+	return true;
 }
 
 void Layer::shift_weights(const core::f32 factor) {
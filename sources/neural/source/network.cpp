@@ -1,10 +1,13 @@
 #include <ranges>
 #include <algorithm>
 #include <execution>
+#include <core/common>
 
 #include "neural/network.hpp"
 #include "neural/edge.hpp"
+#include "neural/neuron.hpp"
 #include "neural/activation/sigmoid_function.hpp"
+#include "neural/activation/softmax_function.hpp"
 
 namespace golxzn::neural {
 
@@ -21,14 +24,15 @@ void Network::generate_values(const bool run_randomize) noexcept {
 }
 
 void Network::add_layer(const Layer::Settings &settings) noexcept {
-	mLayers.emplace_back(std::make_shared<Layer>(
-		static_cast<core::id::type>(mLayers.size()), shared_from_this(), settings
-	));
+	add_layer(Layer::Settings{ settings });
 }
 void Network::add_layer(Layer::Settings &&settings) noexcept {
-	mLayers.emplace_back(std::make_shared<Layer>(
-		static_cast<core::id::type>(mLayers.size()), shared_from_this(), std::move(settings)
-	));
+	/// The layer hands itself to its neurons, so it's initialized once it's owned by the pointer
+	auto layer{ std::make_shared<Layer>(
+		static_cast<core::id::type>(mLayers.size()), weak_from_this().lock(), std::move(settings)
+	) };
+	layer->initialize();
+	mLayers.emplace_back(std::move(layer));
 }
 
 void Network::clean() {
@@ -39,16 +43,19 @@ void Network::clean() {
 
 void Network::set_input(const vec_t<core::f32> &values) noexcept {
 	if (mLayers.empty()) [[unlikely]] return;
-	clean();
+	for (auto &layer : mLayers) {
+		if (layer != nullptr) [[likely]] layer->reset();
+	}
 	if (auto &layer{ mLayers.front() }; layer != nullptr) [[likely]] {
 		layer->set_accumulate(values);
 	}
 }
 
 void Network::trigger() {
-	std::for_each(std::execution::par, std::begin(mLayers), std::end(mLayers), // maybe std::begin(mLayers) + 1
-		[](auto &&layer) { layer->trigger(); }
-	);
+	/// Each layer needs the complete accumulated values of the previous one
+	for (auto &layer : mLayers) {
+		if (layer != nullptr) [[likely]] layer->trigger();
+	}
 }
 
 Network::vec_t<core::f32> Network::output() const noexcept {
@@ -83,13 +90,38 @@ void Network::alter_weights(const three_vec_t<core::f32> &weights) noexcept {
 
 void Network::shift_back_weights(const three_vec_t<core::f32> &weights) noexcept {
 	if (mLayers.empty() || weights.size() != mLayers.size()) [[unlikely]] return;
-	using size_type = three_vec_t<core::f32>::size_type;
 
-	std::ranges::for_each(std::views::iota(size_type{}, weights.size()), [&](auto &&index) {
+	/// The whole layout is checked before the first weight is shifted
+	Gradient gradient{ *this };
+	if (!gradient.assign(weights)) [[unlikely]] {
+		spdlog::error("[{}]: The shifts don't match the network layout", class_name.data());
+		return;
+	}
+	shift_back_weights(gradient);
+}
+
+void Network::shift_back_weights(const Gradient &gradient) {
+	if (mLayers.empty() || gradient.layers_count() != mLayers.size()) [[unlikely]] return;
+
+	for (core::u32 index{}; index < mLayers.size(); ++index) {
 		if (auto &&layer{ mLayers.at(index) }; layer != nullptr) [[likely]] {
-			layer->shift_back_weights(weights.at(index));
+			layer->shift_back_weights(gradient.layer(index));
 		}
-	});
+	}
+}
+
+bool Network::back_propagation_shifts(const vec_t<core::f32> &target_values, Gradient &gradient) {
+	if (mLayers.empty()) [[unlikely]] return false;
+
+	gradient.reshape(*this);
+	for (auto index{ static_cast<core::u32>(mLayers.size()) }; index-- > 0;) {
+		if (auto &&layer{ mLayers.at(index) }; layer != nullptr) [[likely]] {
+			if (!layer->write_back_propagation_shifts(target_values, gradient.layer(index), gradient.output())) {
+				return false;
+			}
+		}
+	}
+	return true;
 }
 
 Network::three_vec_t<core::f32> Network::weights() const noexcept {
@@ -137,7 +169,17 @@ void Network::randomize(const core::f32 range) noexcept {
 
 core::f32 Network::loss(const vec_t<core::f32> &in, const vec_t<core::f32> &out) {
 	using namespace core::types_literals;
-	if (mLayers.empty() || in.size() != out.size()) [[unlikely]] return 0.0_f32;
+	if (mLayers.empty()) [[unlikely]] return 0.0_f32;
+
+	if (auto &layer{ mLayers.back() }; layer != nullptr && layer->is_softmax()) {
+		set_input(in);
+		trigger();
+		mOutput.resize(layer->neuron_count());
+		if (!layer->raw_output(mOutput)) [[unlikely]] return 0.0_f32;
+		return activation::SoftmaxFunction::cross_entropy(mOutput, out).value_or(0.0_f32);
+	}
+
+	if (in.size() != out.size()) [[unlikely]] return 0.0_f32;
 
 	const auto predicted{ predict(in) };
 	const core::f32 coeff{ get_loss_coefficient() };
@@ -173,6 +215,27 @@ Network::vec_t<core::f32> Network::predict(const vec_t<core::f32> &in) noexcept
 	return output();
 }
 
+Network::vec_t<core::f32> Network::input_gradient() const noexcept {
+	using namespace core::types_literals;
+	if (mLayers.empty() || mLayers.front() == nullptr) [[unlikely]] return {};
+
+	const auto &neurons{ mLayers.front()->neurons() };
+	vec_t<core::f32> gradient;
+	gradient.reserve(neurons.size());
+	for (const auto &neuron : neurons) {
+		if (neuron == nullptr || neuron->is_bias()) [[unlikely]] continue;
+
+		const auto &edges{ neuron->edges() };
+		gradient.emplace_back(std::accumulate(std::begin(edges), std::end(edges), 0.0_f32,
+			[](auto acc, auto &edge) {
+				if (edge == nullptr) [[unlikely]] return acc;
+				return acc + edge->back_propagated() * edge->weight();
+			}
+		));
+	}
+	return gradient;
+}
+
 core::f32 Network::get_loss_coefficient() const noexcept {
 	using namespace core::types_literals;
 	if (mLayers.empty()) [[unlikely]] return 1.0_f32;
@@ -60,6 +60,10 @@ const std::vector<core::sptr<Edge>> &Neuron::edges() const noexcept {
 	return mNextEdges;
 }
 
+core::u32 Neuron::previous_edges_count() const noexcept {
+	return static_cast<core::u32>(mPreviousEdges.size());
+}
+
 void Neuron::clean() noexcept {
 	using namespace core::types_literals;
 	set_accumulate(0.0_f32);
@@ -139,27 +143,46 @@ void Neuron::alter_weights(const std::vector<core::f32> &weights) {
 }
 
 void Neuron::shift_back_weights(const std::vector<core::f32> &range) {
+	shift_back_weights(std::span<const core::f32>{ range });
+}
+
+void Neuron::shift_back_weights(std::span<const core::f32> range) {
 	if (range.size() != mPreviousEdges.size()) [[unlikely]] {
 		throw std::invalid_argument{ "Neuron::shift_back_weights - Invalid range size" };
 	}
 
-	size_t index{};
-	std::ranges::for_each(mPreviousEdges, [&range, &index](auto &edge) {
-		if (edge == nullptr) [[unlikely]] return;
-		edge->shift_weight(range.at(index++));
-	});
+	auto value{ std::begin(range) };
+	for (auto &edge : mPreviousEdges) {
+		const auto shift{ *value++ };
+		if (edge == nullptr) [[unlikely]] continue;
+		edge->shift_weight(shift);
+	}
 }
 
 std::vector<core::f32> Neuron::get_back_propagation_shifts(
 	[[maybe_unused]] const std::vector<core::f32> &target_values) {
 
-	using namespace core::types_literals;
+	return get_back_propagation_shifts(make_back_propagated(target_values));
+}
 
-	std::vector<core::f32> shifts;
-	shifts.reserve(mPreviousEdges.size());
+std::vector<core::f32> Neuron::get_back_propagation_shifts(const core::f32 prop_value) {
+	std::vector<core::f32> shifts(mPreviousEdges.size());
+	write_back_propagation_shifts(prop_value, shifts);
+	return shifts;
+}
 
-	const auto prop_value{ make_back_propagated(target_values) };
-	std::ranges::transform(mPreviousEdges, std::back_inserter(shifts), [prop_value](auto &edge) {
+void Neuron::write_back_propagation_shifts(const std::vector<core::f32> &target_values,
+	std::span<core::f32> shifts) {
+	write_back_propagation_shifts(make_back_propagated(target_values), shifts);
+}
+
+void Neuron::write_back_propagation_shifts(const core::f32 prop_value, std::span<core::f32> shifts) {
+	using namespace core::types_literals;
+	if (shifts.size() != mPreviousEdges.size()) [[unlikely]] {
+		throw std::invalid_argument{ "Neuron::write_back_propagation_shifts - Invalid shifts size" };
+	}
+
+	std::ranges::transform(mPreviousEdges, std::begin(shifts), [prop_value](auto &edge) {
 		if (edge == nullptr) [[unlikely]] return 0.0_f32;
 		if (auto previous{ edge->previous() }; previous != nullptr) [[likely]] {
 			edge->set_back_propagated(prop_value);
@@ -168,8 +191,6 @@ std::vector<core::f32> Neuron::get_back_propagation_shifts(
 		spdlog::warn("[Neuron]: Previous neuron is nullptr");
 		return 0.0_f32;
 	});
-
-	return shifts;
 }
 
 core::f32 Neuron::make_back_propagated(const std::vector<core::f32> &target_values) const {
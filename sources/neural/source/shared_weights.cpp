@@ -0,0 +1,76 @@
+#include <core/common>
+
+#include "neural/shared_weights.hpp"
+#include "neural/network.hpp"
+#include "neural/neuron.hpp"
+
+namespace golxzn::neural {
+
+core::sptr<const SharedWeights> SharedWeights::snapshot(const Network &network) {
+	std::vector<core::u32> topology;
+	std::vector<core::sptr<activation::IFunction>> activations;
+	std::vector<core::f32> weights;
+
+	for (const auto &layer : network.layers()) {
+		if (layer == nullptr) [[unlikely]] return nullptr;
+
+		const auto &neurons{ layer->neurons() };
+		const auto count{ std::ranges::count_if(neurons, [](const auto &neuron) { return !neuron->is_bias(); }) };
+		topology.emplace_back(static_cast<core::u32>(count));
+		activations.emplace_back(layer->activation());
+
+		if (layer->is(Layer::Type::Output)) continue;
+		for (const auto &neuron_weights : layer->weights()) {
+			weights.insert(std::end(weights), std::begin(neuron_weights), std::end(neuron_weights));
+		}
+	}
+
+	auto result{ std::make_shared<const SharedWeights>(
+		std::move(topology), std::move(activations), std::move(weights)
+	) };
+	return result->valid() ? result : nullptr;
+}
+
+SharedWeights::SharedWeights(std::vector<core::u32> &&topology,
+	std::vector<core::sptr<activation::IFunction>> &&activations,
+	std::vector<core::f32> &&weights)
+	: mTopology{ std::move(topology) }, mActivations{ std::move(activations) }, mWeights{ std::move(weights) } {
+
+	size_t offset{};
+	for (size_t layer{}; layer + 1 < mTopology.size(); ++layer) {
+		mOffsets.emplace_back(offset);
+		offset += (static_cast<size_t>(mTopology[layer]) + 1) * mTopology[layer + 1];
+	}
+	mOffsets.emplace_back(offset);
+
+	if (mTopology.size() < 2 || mActivations.size() != mTopology.size() || offset != mWeights.size()) [[unlikely]] {
+		spdlog::error("[{}]: Invalid layout: {} layers, {} activations, {} weights instead of {}",
+			class_name, mTopology.size(), mActivations.size(), mWeights.size(), offset);
+		mTopology.clear();
+		mActivations.clear();
+		mWeights.clear();
+		mOffsets.clear();
+		return;
+	}
+	mMaxWidth = *std::ranges::max_element(mTopology);
+}
+
+bool SharedWeights::valid() const noexcept { return !mTopology.empty(); }
+
+core::u32 SharedWeights::layers_count() const noexcept { return static_cast<core::u32>(mTopology.size()); }
+core::u32 SharedWeights::input_count() const noexcept { return valid() ? mTopology.front() : 0; }
+core::u32 SharedWeights::output_count() const noexcept { return valid() ? mTopology.back() : 0; }
+core::u32 SharedWeights::max_width() const noexcept { return mMaxWidth; }
+
+const std::vector<core::u32> &SharedWeights::topology() const noexcept { return mTopology; }
+const std::vector<core::sptr<activation::IFunction>> &SharedWeights::activations() const noexcept {
+	return mActivations;
+}
+std::span<const core::f32> SharedWeights::weights() const noexcept { return mWeights; }
+
+std::span<const core::f32> SharedWeights::block(const core::u32 layer) const noexcept {
+	if (layer + 1 >= mOffsets.size()) [[unlikely]] return {};
+	return std::span{ mWeights }.subspan(mOffsets[layer], mOffsets[layer + 1] - mOffsets[layer]);
+}
+
+} // namespace golxzn::neural
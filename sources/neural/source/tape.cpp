@@ -0,0 +1,197 @@
+#include <cmath>
+#include <cassert>
+#include <algorithm>
+#include <core/common>
+
+#include "neural/tape.hpp"
+
+namespace golxzn::neural {
+
+Tape::Tape(const size_t capacity) {
+	reserve(capacity);
+}
+
+Tape::Variable Tape::variable(const value_type value) {
+	return record(value, no_parent, value_type{});
+}
+
+std::vector<Tape::Variable> Tape::variables(std::span<const value_type> values) {
+	reserve(mSize + values.size());
+
+	std::vector<Variable> result;
+	result.reserve(values.size());
+	std::ranges::transform(values, std::back_inserter(result),
+		[this](const auto value) { return variable(value); });
+	return result;
+}
+
+Tape::Variable Tape::record(const value_type value,
+		const index_type lhs, const value_type lhs_partial,
+		const index_type rhs, const value_type rhs_partial) {
+	if (mSize == mValues.size()) [[unlikely]] {
+		grow();
+	}
+
+	mValues[mSize] = value;
+	mLhs[mSize] = lhs;
+	mRhs[mSize] = rhs;
+	mLhsPartials[mSize] = lhs_partial;
+	mRhsPartials[mSize] = rhs_partial;
+	return Variable{ this, static_cast<index_type>(mSize++) };
+}
+
+Tape::value_type Tape::value(const Variable &variable) const noexcept {
+	assert(variable.mTape == this && variable.mIndex < mSize && "The variable doesn't belong to the tape");
+	return mValues[variable.mIndex];
+}
+
+Tape::value_type Tape::adjoint(const Variable &variable) const noexcept {
+	assert(variable.mTape == this && variable.mIndex < mSize && "The variable doesn't belong to the tape");
+	return mAdjoints[variable.mIndex];
+}
+
+std::span<const Tape::value_type> Tape::adjoints() const noexcept {
+	return std::span{ mAdjoints }.first(mSize);
+}
+
+void Tape::backward(const Variable &output, const value_type seed) noexcept {
+	if (output.mTape != this || output.mIndex >= mSize) [[unlikely]] {
+		spdlog::error("[{}]: Cannot run backward pass from the foreign variable", class_name.data());
+		return;
+	}
+
+	std::fill_n(std::begin(mAdjoints), mSize, value_type{});
+	mAdjoints[output.mIndex] = seed;
+
+	for (auto index{ static_cast<size_t>(output.mIndex) + 1 }; index-- > 0;) {
+		const auto adjoint{ mAdjoints[index] };
+		if (adjoint == value_type{}) continue;
+
+		if (const auto lhs{ mLhs[index] }; lhs != no_parent) {
+			mAdjoints[lhs] += adjoint * mLhsPartials[index];
+		}
+		if (const auto rhs{ mRhs[index] }; rhs != no_parent) {
+			mAdjoints[rhs] += adjoint * mRhsPartials[index];
+		}
+	}
+}
+
+void Tape::reset() noexcept { mSize = 0; }
+
+void Tape::reserve(const size_t capacity) {
+	if (capacity <= mValues.size()) return;
+
+	mValues.resize(capacity);
+	mAdjoints.resize(capacity);
+	mLhs.resize(capacity);
+	mRhs.resize(capacity);
+	mLhsPartials.resize(capacity);
+	mRhsPartials.resize(capacity);
+}
+
+size_t Tape::size() const noexcept { return mSize; }
+size_t Tape::capacity() const noexcept { return mValues.size(); }
+
+Tape::Variable Tape::sum(std::span<const Variable> values) {
+	if (values.empty()) [[unlikely]] return variable(value_type{});
+
+	auto result{ values.front() };
+	for (const auto &value : values.subspan(1)) {
+		result = result + value;
+	}
+	return result;
+}
+
+Tape::Variable Tape::dot(std::span<const Variable> lhs, std::span<const Variable> rhs) {
+	assert(lhs.size() == rhs.size() && "The sizes of the vectors must be equal");
+	if (lhs.empty()) [[unlikely]] return variable(value_type{});
+
+	auto result{ lhs.front() * rhs.front() };
+	for (size_t i{ 1 }; i < lhs.size(); ++i) {
+		result = result + lhs[i] * rhs[i];
+	}
+	return result;
+}
+
+void Tape::grow() {
+	static constexpr size_t initial_capacity{ 64 };
+	reserve((std::max)(initial_capacity, mValues.size() * 2));
+}
+
+//========================================== operators ===========================================//
+
+namespace {
+
+Tape &tape_of(const Tape::Variable &value) noexcept {
+	assert(value.tape() != nullptr && "The variable isn't recorded");
+	return *value.tape();
+}
+
+} // anonymous namespace
+
+using namespace core::types_literals;
+
+Tape::Variable operator+(const Tape::Variable &lhs, const Tape::Variable &rhs) {
+	return tape_of(lhs).record(lhs.value() + rhs.value(), lhs.index(), 1.0_f32, rhs.index(), 1.0_f32);
+}
+Tape::Variable operator-(const Tape::Variable &lhs, const Tape::Variable &rhs) {
+	return tape_of(lhs).record(lhs.value() - rhs.value(), lhs.index(), 1.0_f32, rhs.index(), -1.0_f32);
+}
+Tape::Variable operator*(const Tape::Variable &lhs, const Tape::Variable &rhs) {
+	return tape_of(lhs).record(lhs.value() * rhs.value(), lhs.index(), rhs.value(), rhs.index(), lhs.value());
+}
+Tape::Variable operator/(const Tape::Variable &lhs, const Tape::Variable &rhs) {
+	const auto inverse{ 1.0_f32 / rhs.value() };
+	return tape_of(lhs).record(lhs.value() * inverse,
+		lhs.index(), inverse, rhs.index(), -lhs.value() * inverse * inverse);
+}
+Tape::Variable operator-(const Tape::Variable &value) {
+	return tape_of(value).record(-value.value(), value.index(), -1.0_f32);
+}
+
+Tape::Variable operator+(const Tape::Variable &lhs, const Tape::value_type rhs) {
+	return tape_of(lhs).record(lhs.value() + rhs, lhs.index(), 1.0_f32);
+}
+Tape::Variable operator-(const Tape::Variable &lhs, const Tape::value_type rhs) {
+	return tape_of(lhs).record(lhs.value() - rhs, lhs.index(), 1.0_f32);
+}
+Tape::Variable operator*(const Tape::Variable &lhs, const Tape::value_type rhs) {
+	return tape_of(lhs).record(lhs.value() * rhs, lhs.index(), rhs);
+}
+Tape::Variable operator/(const Tape::Variable &lhs, const Tape::value_type rhs) {
+	return tape_of(lhs).record(lhs.value() / rhs, lhs.index(), 1.0_f32 / rhs);
+}
+Tape::Variable operator+(const Tape::value_type lhs, const Tape::Variable &rhs) { return rhs + lhs; }
+Tape::Variable operator-(const Tape::value_type lhs, const Tape::Variable &rhs) {
+	return tape_of(rhs).record(lhs - rhs.value(), rhs.index(), -1.0_f32);
+}
+Tape::Variable operator*(const Tape::value_type lhs, const Tape::Variable &rhs) { return rhs * lhs; }
+Tape::Variable operator/(const Tape::value_type lhs, const Tape::Variable &rhs) {
+	const auto inverse{ 1.0_f32 / rhs.value() };
+	return tape_of(rhs).record(lhs * inverse, rhs.index(), -lhs * inverse * inverse);
+}
+
+Tape::Variable exp(const Tape::Variable &value) {
+	const auto result{ std::exp(value.value()) };
+	return tape_of(value).record(result, value.index(), result);
+}
+Tape::Variable log(const Tape::Variable &value) {
+	return tape_of(value).record(std::log(value.value()), value.index(), 1.0_f32 / value.value());
+}
+Tape::Variable tanh(const Tape::Variable &value) {
+	const auto result{ std::tanh(value.value()) };
+	return tape_of(value).record(result, value.index(), 1.0_f32 - result * result);
+}
+Tape::Variable sigmoid(const Tape::Variable &value) {
+	const auto result{ 1.0_f32 / (1.0_f32 + std::exp(-value.value())) };
+	return tape_of(value).record(result, value.index(), result * (1.0_f32 - result));
+}
+Tape::Variable relu(const Tape::Variable &value) {
+	const auto positive{ value.value() > 0.0_f32 };
+	return tape_of(value).record(positive ? value.value() : 0.0_f32, value.index(), positive ? 1.0_f32 : 0.0_f32);
+}
+Tape::Variable square(const Tape::Variable &value) {
+	return tape_of(value).record(value.value() * value.value(), value.index(), 2.0_f32 * value.value());
+}
+
+} // namespace golxzn::neural
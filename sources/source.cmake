@@ -9,6 +9,10 @@ list(APPEND libraries
 	golxzn::bot
 )
 
+if(GTBOT_BUILD_TOOLS)
+	add_subdirectory(${GTBOT_SOURCES_DIR}/tools)
+endif()
+
 if(GTBOT_CONFIGURE_MODULE MATCHES Platform)
 	add_subdirectory(${GTBOT_PLATFORM_SOURCES_DIR})
 elseif(GTBOT_CONFIGURE_MODULE MATCHES Tests)
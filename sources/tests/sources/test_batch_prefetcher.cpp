@@ -0,0 +1,113 @@
+#include <core/common>
+#include <neural/batch_prefetcher.hpp>
+#include <gtest/gtest.h>
+
+TEST(BatchPrefetcherTest, GathersSplitInOrder) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::BatchPrefetcher;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 100_u32; ++line) {
+		const auto value{ static_cast<golxzn::core::f32>(line) };
+		dataset.append({ value, value * 2.0_f32 }, { -value });
+	}
+	dataset.split(0.7_f32, 5_u64);
+
+	BatchPrefetcher prefetcher{ dataset, Dataset::Type::Train, BatchPrefetcher::Settings{
+		.batch_size = 16,
+		.prefetch_count = 2,
+		.drop_last = false,
+		.statistics = nullptr,
+	} };
+
+	for (int epoch{}; epoch < 2; ++epoch) {
+		const auto lines{ dataset.get_lines(Dataset::Type::Train) };
+		size_t gathered{};
+		for (auto batch{ prefetcher.next() }; !batch.empty(); batch = prefetcher.next()) {
+			EXPECT_EQ(reinterpret_cast<std::uintptr_t>(batch.inputs().data()) % BatchPrefetcher::alignment, 0);
+			ASSERT_EQ(batch.inputs().size(), batch.size() * 2_u32);
+			for (golxzn::core::u32 i{}; i < batch.size(); ++i) {
+				const auto expected{ static_cast<golxzn::core::f32>(lines[gathered + i]) };
+				EXPECT_DOUBLE_EQ(batch.inputs()[i * 2], expected);
+				EXPECT_DOUBLE_EQ(batch.inputs()[i * 2 + 1], expected * 2.0);
+				EXPECT_DOUBLE_EQ(batch.outputs()[i], -expected);
+			}
+			gathered += batch.size();
+		}
+		EXPECT_EQ(gathered, lines.size());
+
+		dataset.shuffle(static_cast<golxzn::core::u64>(epoch));
+		prefetcher.restart();
+	}
+	EXPECT_EQ(prefetcher.metrics().batches, 10_u64);
+}
+
+TEST(BatchPrefetcherTest, StandardizesAndDropsLast) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::BatchPrefetcher;
+	using golxzn::neural::FeatureStatistics;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 10_u32; ++line) {
+		dataset.append({ static_cast<golxzn::core::f32>(line) }, { 1.0_f32 });
+	}
+	dataset.split(1.0_f32, 1_u64);
+
+	auto statistics{ std::make_shared<const FeatureStatistics>(FeatureStatistics::compute(dataset)) };
+	BatchPrefetcher prefetcher{ dataset, Dataset::Type::Train, BatchPrefetcher::Settings{
+		.batch_size = 4,
+		.prefetch_count = 2,
+		.drop_last = true,
+		.statistics = statistics,
+	} };
+
+	golxzn::core::f32 sum{};
+	golxzn::core::u32 batches{};
+	for (auto batch{ prefetcher.next() }; !batch.empty(); batch = prefetcher.next(), ++batches) {
+		EXPECT_EQ(batch.size(), 4_u32);
+		for (const auto value : batch.inputs()) {
+			EXPECT_LT(std::abs(value), 2.0);
+			sum += value;
+		}
+	}
+	EXPECT_EQ(batches, 2_u32);
+	EXPECT_TRUE(std::isfinite(sum));
+}
+
+TEST(BatchPrefetcherTest, ShuffleWhileGathering) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::BatchPrefetcher;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 64_u32; ++line) {
+		dataset.append({ static_cast<golxzn::core::f32>(line) }, { 0.0_f32 });
+	}
+	dataset.split(1.0_f32, 3_u64);
+
+	const auto lines{ dataset.get_lines(Dataset::Type::Train) };
+	const std::vector order(std::begin(lines), std::end(lines));
+	BatchPrefetcher prefetcher{ dataset, Dataset::Type::Train, BatchPrefetcher::Settings{
+		.batch_size = 4,
+		.prefetch_count = 2,
+		.drop_last = false,
+		.statistics = nullptr,
+	} };
+
+	/// The running epoch keeps the order it started with
+	size_t gathered{};
+	for (auto batch{ prefetcher.next() }; !batch.empty(); batch = prefetcher.next()) {
+		if (gathered == 0) dataset.shuffle(7_u64);
+		for (const auto value : batch.inputs()) {
+			EXPECT_DOUBLE_EQ(value, static_cast<golxzn::core::f32>(order[gathered++]));
+		}
+	}
+	EXPECT_EQ(gathered, order.size());
+
+	prefetcher.restart();
+	const auto batch{ prefetcher.next() };
+	ASSERT_FALSE(batch.empty());
+	EXPECT_DOUBLE_EQ(batch.inputs()[0], static_cast<golxzn::core::f32>(dataset.get_lines(Dataset::Type::Train)[0]));
+}
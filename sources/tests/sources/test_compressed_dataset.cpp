@@ -0,0 +1,49 @@
+#include <core/common>
+#include <neural/compressed_dataset.hpp>
+#include <gtest/gtest.h>
+
+TEST(CompressedDatasetTest, RoundTrip) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::CompressedDataset;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 1000_u32; ++line) {
+		dataset.append({ static_cast<Dataset::value_type>(line), 0.5_f32 }, { static_cast<Dataset::value_type>(line % 3) });
+	}
+
+	auto content{ CompressedDataset::compress(dataset, CompressedDataset::Settings{
+		.lines_per_block = 64,
+		.threads_count = 3,
+	}) };
+	ASSERT_FALSE(content.empty());
+	EXPECT_LT(content.size(), dataset.data().size_bytes());
+
+	const CompressedDataset compressed{ std::move(content) };
+	ASSERT_TRUE(compressed.is_open());
+	EXPECT_EQ(compressed.blocks_count(), 16_u32);
+	EXPECT_EQ(compressed.lines_count(), 1000_u64);
+	EXPECT_EQ(compressed.block_lines_count(15_u32), 40_u32);
+
+	std::vector<Dataset::value_type> block;
+	ASSERT_TRUE(compressed.read_block(2_u32, block));
+	EXPECT_DOUBLE_EQ(block.front(), 128.0);
+
+	const auto loaded{ compressed.load(4_u32) };
+	EXPECT_TRUE(std::ranges::equal(loaded.data(), dataset.data()));
+
+	golxzn::core::u32 expected_block{};
+	golxzn::core::u64 lines{};
+	EXPECT_TRUE(compressed.stream([&](const auto index, const auto values) {
+		EXPECT_EQ(index, expected_block++);
+		lines += values.size() / 3;
+	}, 2_u32));
+	EXPECT_EQ(lines, 1000_u64);
+}
+
+TEST(CompressedDatasetTest, RejectsCorrupted) {
+	using golxzn::neural::CompressedDataset;
+
+	EXPECT_FALSE(CompressedDataset{ std::vector<golxzn::core::byte>(8) }.is_open());
+	EXPECT_FALSE(CompressedDataset{ std::vector<golxzn::core::byte>(64) }.is_open());
+}
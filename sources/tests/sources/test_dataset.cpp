@@ -41,19 +41,16 @@ TEST(DatasetTest, ConstructFromRawData) {
 	EXPECT_EQ(dataset.get_input_count(), 2_u32);
 	EXPECT_EQ(dataset.get_output_count(), 1_u32);
 
-	const auto &raw_input{ dataset.get_raw_input() };
-	EXPECT_EQ(raw_input.size(), 5_u32);
-	for (const auto &line : raw_input) {
-		EXPECT_EQ(line.size(), 2_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.4 });
-		EXPECT_DOUBLE_EQ(line.at(1), dataset_value_type{ -1.8 });
-	}
+	EXPECT_EQ(dataset.lines_count(), 5_u32);
+	for (golxzn::core::u32 line{}; line < dataset.lines_count(); ++line) {
+		const auto input{ dataset.input(line) };
+		EXPECT_EQ(input.size(), 2_u32);
+		EXPECT_DOUBLE_EQ(input[0], dataset_value_type{ 1.4 });
+		EXPECT_DOUBLE_EQ(input[1], dataset_value_type{ -1.8 });
 
-	const auto &raw_output{ dataset.get_raw_output() };
-	EXPECT_EQ(raw_output.size(), 5_u32);
-	for (const auto &line : raw_output) {
-		EXPECT_EQ(line.size(), 1_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.0 });
+		const auto output{ dataset.output(line) };
+		EXPECT_EQ(output.size(), 1_u32);
+		EXPECT_DOUBLE_EQ(output[0], dataset_value_type{ 1.0 });
 	}
 
 	const auto raw{ dataset.raw() };
@@ -69,19 +66,16 @@ TEST(DatasetTest, ConstructFromFile) {
 	EXPECT_EQ(dataset.get_input_count(), 2_u32);
 	EXPECT_EQ(dataset.get_output_count(), 1_u32);
 
-	const auto &raw_input{ dataset.get_raw_input() };
-	EXPECT_EQ(raw_input.size(), 5_u32);
-	for (const auto &line : raw_input) {
-		EXPECT_EQ(line.size(), 2_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.4 });
-		EXPECT_DOUBLE_EQ(line.at(1), dataset_value_type{ -1.8 });
-	}
+	EXPECT_EQ(dataset.lines_count(), 5_u32);
+	for (golxzn::core::u32 line{}; line < dataset.lines_count(); ++line) {
+		const auto input{ dataset.input(line) };
+		EXPECT_EQ(input.size(), 2_u32);
+		EXPECT_DOUBLE_EQ(input[0], dataset_value_type{ 1.4 });
+		EXPECT_DOUBLE_EQ(input[1], dataset_value_type{ -1.8 });
 
-	const auto &raw_output{ dataset.get_raw_output() };
-	EXPECT_EQ(raw_output.size(), 5_u32);
-	for (const auto &line : raw_output) {
-		EXPECT_EQ(line.size(), 1_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.0 });
+		const auto output{ dataset.output(line) };
+		EXPECT_EQ(output.size(), 1_u32);
+		EXPECT_DOUBLE_EQ(output[0], dataset_value_type{ 1.0 });
 	}
 
 	const auto raw{ dataset.raw() };
@@ -97,19 +91,16 @@ TEST(DatasetTest, ConstructFromFileWithCounts) {
 	EXPECT_EQ(dataset.get_input_count(), 2_u32);
 	EXPECT_EQ(dataset.get_output_count(), 1_u32);
 
-	const auto &raw_input{ dataset.get_raw_input() };
-	EXPECT_EQ(raw_input.size(), 5_u32);
-	for (const auto &line : raw_input) {
-		EXPECT_EQ(line.size(), 2_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.4 });
-		EXPECT_DOUBLE_EQ(line.at(1), dataset_value_type{ -1.8 });
-	}
+	EXPECT_EQ(dataset.lines_count(), 5_u32);
+	for (golxzn::core::u32 line{}; line < dataset.lines_count(); ++line) {
+		const auto input{ dataset.input(line) };
+		EXPECT_EQ(input.size(), 2_u32);
+		EXPECT_DOUBLE_EQ(input[0], dataset_value_type{ 1.4 });
+		EXPECT_DOUBLE_EQ(input[1], dataset_value_type{ -1.8 });
 
-	const auto &raw_output{ dataset.get_raw_output() };
-	EXPECT_EQ(raw_output.size(), 5_u32);
-	for (const auto &line : raw_output) {
-		EXPECT_EQ(line.size(), 1_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.0 });
+		const auto output{ dataset.output(line) };
+		EXPECT_EQ(output.size(), 1_u32);
+		EXPECT_DOUBLE_EQ(output[0], dataset_value_type{ 1.0 });
 	}
 
 	const auto raw{ dataset.raw() };
@@ -121,40 +112,182 @@ TEST(DatasetTest, AppendAndErase) {
 	using namespace golxzn::types_literals;
 	using dataset_value_type = golxzn::neural::Dataset::value_type;
 
-	golxzn::neural::Dataset dataset{};
-	dataset
-		.append({ 1.4_f32, -1.8_f32 }, { 1.1_f32, 0.5_f32 })
-		.append({ 2.4_f32, -1.8_f32 }, { 2.1_f32, 0.5_f32 })
-		.append({ 3.4_f32, -1.8_f32 }, { 3.1_f32, 0.5_f32 });
+	for (const auto layout : { golxzn::neural::Dataset::Layout::RowMajor, golxzn::neural::Dataset::Layout::ColumnMajor }) {
+		golxzn::neural::Dataset dataset{ layout };
+		dataset
+			.append({ 1.4_f32, -1.8_f32 }, { 1.1_f32, 0.5_f32 })
+			.append({ 2.4_f32, -1.8_f32 }, { 2.1_f32, 0.5_f32 })
+			.append({ 3.4_f32, -1.8_f32 }, { 3.1_f32, 0.5_f32 });
+
+		EXPECT_EQ(dataset.get_input_count(), 2_u32);
+		EXPECT_EQ(dataset.get_output_count(), 2_u32);
+		EXPECT_EQ(dataset.lines_count(), 3_u32);
+
+		std::array<dataset_value_type, 2> input{};
+		std::array<dataset_value_type, 2> output{};
+		dataset_value_type increaser{};
+		for (golxzn::core::u32 line{}; line < dataset.lines_count(); ++line) {
+			ASSERT_TRUE(dataset.read_line(line, input, output));
+			EXPECT_DOUBLE_EQ(input[0], dataset_value_type{ 1.4 + increaser });
+			EXPECT_DOUBLE_EQ(input[1], dataset_value_type{ -1.8 });
+			EXPECT_DOUBLE_EQ(output[0], dataset_value_type{ 1.1 + increaser });
+			EXPECT_DOUBLE_EQ(output[1], dataset_value_type{ 0.5 });
+			increaser += 1.0_f32;
+		}
+
+		dataset.erase(1_u32);
+		EXPECT_EQ(dataset.lines_count(), 2_u32);
+		EXPECT_DOUBLE_EQ(dataset.at(0_u32, 0_u32), dataset_value_type{ 1.4 });
+		EXPECT_DOUBLE_EQ(dataset.at(1_u32, 0_u32), dataset_value_type{ 3.4 });
+		EXPECT_DOUBLE_EQ(dataset.at(1_u32, 2_u32), dataset_value_type{ 3.1 });
+	}
+}
+
+TEST(DatasetTest, Layouts) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+
+	Dataset dataset{ raw_data, 2_u32, 1_u32, Dataset::Layout::ColumnMajor };
+	EXPECT_EQ(dataset.layout(), Dataset::Layout::ColumnMajor);
+	EXPECT_TRUE(dataset.line(0_u32).empty());
 
+	const auto second{ dataset.column(1_u32) };
+	ASSERT_EQ(second.size(), 5_u32);
+	EXPECT_TRUE(std::ranges::all_of(second, [](const auto value) { return value == Dataset::value_type{ -1.8 }; }));
+	EXPECT_TRUE(std::ranges::equal(raw_data, dataset.raw()));
+
+	dataset.set_layout(Dataset::Layout::RowMajor);
+	EXPECT_TRUE(dataset.column(1_u32).empty());
+	EXPECT_EQ(dataset.line(4_u32).size(), 3_u32);
+	EXPECT_TRUE(std::ranges::equal(raw_data, dataset.raw()));
+}
+
+TEST(DatasetTest, MapFile) {
+	using namespace golxzn::types_literals;
+	using dataset_value_type = golxzn::neural::Dataset::value_type;
+
+	auto dataset{ golxzn::neural::Dataset::map(dataset_with_counts_file) };
+	ASSERT_TRUE(dataset.is_mapped());
 	EXPECT_EQ(dataset.get_input_count(), 2_u32);
-	EXPECT_EQ(dataset.get_output_count(), 2_u32);
-
-	const auto raw_input{ dataset.get_raw_input() };
-	EXPECT_EQ(raw_input.size(), 3_u32);
-	dataset_value_type increaser{};
-	for (const auto &line : raw_input) {
-		EXPECT_EQ(line.size(), 2_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.4 + increaser });
-		EXPECT_DOUBLE_EQ(line.at(1), dataset_value_type{ -1.8 });
-		increaser += 1.0_f32;
+	EXPECT_EQ(dataset.get_output_count(), 1_u32);
+	EXPECT_EQ(dataset.lines_count(), 5_u32);
+	EXPECT_DOUBLE_EQ(dataset.input(4_u32)[1], dataset_value_type{ -1.8 });
+	EXPECT_TRUE(std::ranges::equal(raw_data, dataset.raw()));
+
+	const auto headerless{ golxzn::neural::Dataset::map(dataset_file, 2_u32, 1_u32) };
+	EXPECT_TRUE(std::ranges::equal(raw_data, headerless.raw()));
+
+	dataset.erase(0_u32);
+	EXPECT_FALSE(dataset.is_mapped());
+	EXPECT_EQ(dataset.lines_count(), 4_u32);
+	EXPECT_DOUBLE_EQ(dataset.output(3_u32)[0], dataset_value_type{ 1.0 });
+}
+
+TEST(DatasetTest, SeededSplits) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 100_u32; ++line) {
+		dataset.append({ static_cast<Dataset::value_type>(line) }, { static_cast<Dataset::value_type>(line % 4 == 0) });
+	}
+
+	dataset.split(0.8_f32, 42_u64);
+	const std::vector train(std::begin(dataset.get_lines(Dataset::Type::Train)), std::end(dataset.get_lines(Dataset::Type::Train)));
+	EXPECT_EQ(train.size(), 80_u32);
+	EXPECT_EQ(dataset.get_lines(Dataset::Type::Test).size(), 20_u32);
+
+	dataset.split(0.8_f32, 42_u64);
+	EXPECT_TRUE(std::ranges::equal(train, dataset.get_lines(Dataset::Type::Train)));
+
+	const auto view{ dataset.view(Dataset::Type::Train) };
+	EXPECT_DOUBLE_EQ(view.input(0_u32)[0], static_cast<Dataset::value_type>(train.front()));
+
+	dataset.shuffle(7_u64);
+	auto shuffled{ train };
+	std::ranges::sort(shuffled);
+	std::vector after(std::begin(dataset.get_lines(Dataset::Type::Train)), std::end(dataset.get_lines(Dataset::Type::Train)));
+	std::ranges::sort(after);
+	EXPECT_EQ(shuffled, after);
+
+	dataset.split_stratified(0.8_f32, 1_u64);
+	const auto positives{ std::ranges::count_if(dataset.get_lines(Dataset::Type::Test),
+		[&](const auto line) { return dataset.at(line, 1_u32) == 1.0_f32; }) };
+	EXPECT_EQ(positives, 5);
+	EXPECT_EQ(dataset.get_lines(Dataset::Type::Test).size(), 20_u32);
+
+	/// The continuous output isn't a class, so it's split randomly with the same train count
+	Dataset continuous;
+	for (golxzn::core::u32 line{}; line < 100_u32; ++line) {
+		continuous.append({ 0.0_f32 }, { static_cast<Dataset::value_type>(line) + 0.5_f32 });
+	}
+	continuous.split_stratified(0.3_f32, 1_u64);
+	EXPECT_EQ(continuous.get_lines(Dataset::Type::Train).size(), 30_u32);
+
+	/// Three classes of 7, 7 and 6 lines: the halves 3.5, 3.5 and 3 give 10 train lines, not 11
+	Dataset small;
+	for (golxzn::core::u32 line{}; line < 20_u32; ++line) {
+		small.append({ 0.0_f32 }, { static_cast<Dataset::value_type>(line % 3) });
 	}
+	small.split_stratified(0.5_f32, 2_u64);
+	EXPECT_EQ(small.get_lines(Dataset::Type::Train).size(), 10_u32);
 
-	const auto raw_output{ dataset.get_raw_output() };
-	EXPECT_EQ(raw_output.size(), 3_u32);
-	increaser = 0.0_f32;
-	for (const auto &line : raw_output) {
-		EXPECT_EQ(line.size(), 2_u32);
-		EXPECT_DOUBLE_EQ(line.at(0), dataset_value_type{ 1.1 + increaser });
-		EXPECT_DOUBLE_EQ(line.at(1), dataset_value_type{ 0.5 });
-		increaser += 1.0_f32;
+	std::vector<golxzn::core::u32> tested;
+	for (golxzn::core::u32 fold{}; fold < 5_u32; ++fold) {
+		dataset.split_fold(5_u32, fold, 3_u64);
+		EXPECT_EQ(dataset.get_lines(Dataset::Type::Train).size(), 80_u32);
+		const auto test{ dataset.get_lines(Dataset::Type::Test) };
+		tested.insert(std::end(tested), std::begin(test), std::end(test));
 	}
+	std::ranges::sort(tested);
+	EXPECT_EQ(tested.size(), 100_u32);
+	EXPECT_EQ(std::ranges::unique(tested).size(), 0_u32);
+}
+
+TEST(DatasetTest, BulkAppendAndSwapErase) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
 
-	dataset.erase(1_u32);
+	for (const auto layout : { Dataset::Layout::RowMajor, Dataset::Layout::ColumnMajor }) {
+		Dataset dataset{ layout };
+		const std::vector inputs{ 0.0_f32, 0.5_f32, 1.0_f32, 1.5_f32, 2.0_f32, 2.5_f32 };
+		const std::vector outputs{ 10.0_f32, 11.0_f32, 12.0_f32 };
+		dataset.append_rows(inputs, outputs, 3_u32).append_rows(inputs, outputs, 3_u32);
+		ASSERT_EQ(dataset.lines_count(), 6_u32);
+		EXPECT_EQ(dataset.get_input_count(), 2_u32);
+		EXPECT_DOUBLE_EQ(dataset.at(4_u32, 1_u32), 1.5);
+		EXPECT_DOUBLE_EQ(dataset.at(5_u32, 2_u32), 12.0);
 
-	const auto modified_raw_input{ dataset.get_raw_input() };
-	EXPECT_EQ(modified_raw_input.size(), 2_u32);
+		dataset.split(0.5_f32, 1_u64);
+		dataset.append({ 3.0_f32, 3.5_f32 }, { 13.0_f32 });
+		EXPECT_EQ(dataset.get_lines(Dataset::Type::Train).size(), 3_u32);
 
-	const auto modified_raw_output{ dataset.get_raw_output() };
-	EXPECT_EQ(modified_raw_output.size(), 2_u32);
+		dataset.swap_erase(1_u32);
+		EXPECT_TRUE(dataset.get_lines(Dataset::Type::Train).empty());
+		ASSERT_EQ(dataset.lines_count(), 6_u32);
+		EXPECT_DOUBLE_EQ(dataset.at(1_u32, 0_u32), 3.0);
+		EXPECT_DOUBLE_EQ(dataset.at(1_u32, 2_u32), 13.0);
+		EXPECT_DOUBLE_EQ(dataset.at(5_u32, 2_u32), 12.0);
+
+		dataset.swap_erase(5_u32);
+		EXPECT_EQ(dataset.lines_count(), 5_u32);
+		EXPECT_DOUBLE_EQ(dataset.at(4_u32, 0_u32), 1.0);
+	}
+}
+
+TEST(DatasetTest, BulkAppendRejectsEmptyLines) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+
+	for (const auto layout : { Dataset::Layout::RowMajor, Dataset::Layout::ColumnMajor }) {
+		Dataset dataset{ layout };
+		const std::vector inputs{ 0.0_f32, 0.5_f32 };
+		dataset.append_rows(inputs, std::span<const Dataset::value_type>{}, 2_u32);
+		EXPECT_TRUE(dataset.empty());
+		EXPECT_EQ(dataset.get_input_count(), 0_u32);
+
+		dataset.append_rows(std::span<const Dataset::value_type>{}, inputs, 2_u32);
+		EXPECT_TRUE(dataset.empty());
+		EXPECT_EQ(dataset.get_output_count(), 0_u32);
+	}
 }
@@ -0,0 +1,72 @@
+#include <core/common>
+#include <neural/dataset.hpp>
+#include <neural/dataset_converter.hpp>
+#include <spdlog/sinks/ostream_sink.h>
+#include <gtest/gtest.h>
+
+TEST(DatasetConverterTest, ParsesInParallel) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::DatasetConverter;
+
+	std::string text{ "a,b,label\r\n" };
+	for (int line{}; line < 1000; ++line) {
+		text += fmt::format("{}, {}.5,{}\r\n", line, -line, line % 2);
+	}
+	text += "\n";
+
+	const auto raw{ DatasetConverter::convert(text, DatasetConverter::Settings{
+		.threads_count = 4,
+		.skip_first_line = true,
+	}) };
+	ASSERT_EQ(raw.size(), 8 + 1000 * 3 * sizeof(golxzn::core::f32));
+
+	const std::vector<golxzn::core::byte> body{ std::begin(raw) + 8, std::end(raw) };
+	const Dataset dataset{ body, 2_u32, 1_u32 };
+	ASSERT_EQ(dataset.lines_count(), 1000_u32);
+	for (golxzn::core::u32 line{}; line < dataset.lines_count(); ++line) {
+		EXPECT_DOUBLE_EQ(dataset.at(line, 0_u32), line);
+		EXPECT_DOUBLE_EQ(dataset.at(line, 1_u32), -static_cast<golxzn::core::f32>(line) + (line == 0 ? 0.5 : -0.5));
+		EXPECT_DOUBLE_EQ(dataset.at(line, 2_u32), line % 2);
+	}
+}
+
+TEST(DatasetConverterTest, RejectsMalformed) {
+	using golxzn::neural::DatasetConverter;
+
+	EXPECT_TRUE(DatasetConverter::convert("1,2,3\n4,5\n").empty());
+	EXPECT_TRUE(DatasetConverter::convert("1,x,3\n").empty());
+	EXPECT_TRUE(DatasetConverter::convert("1\n2\n").empty());
+
+	const auto spaces{ DatasetConverter::convert("1 2\n3 4\n", DatasetConverter::Settings{
+		.separator = ' ',
+		.write_counts = false,
+	}) };
+	EXPECT_EQ(spaces.size(), 4 * sizeof(golxzn::core::f32));
+}
+
+TEST(DatasetConverterTest, ReportsPhysicalLine) {
+	using golxzn::neural::DatasetConverter;
+
+	std::ostringstream log;
+	const auto previous{ spdlog::default_logger() };
+	spdlog::set_default_logger(std::make_shared<spdlog::logger>("converter",
+		std::make_shared<spdlog::sinks::ostream_sink_st>(log)));
+
+	/// The blank lines are counted, and the broken line 11 is in the last of the 4 chunks
+	std::string text{ "a,b\n\n" };
+	for (int line{}; line < 7; ++line) {
+		text += fmt::format("{},{}\n", line, line);
+	}
+	text += "\n1,x\n2,2\n";
+	EXPECT_TRUE(DatasetConverter::convert(text, DatasetConverter::Settings{
+		.separator = ',',
+		.output_count = 1,
+		.threads_count = 4,
+		.skip_first_line = true,
+		.write_counts = true,
+	}).empty());
+
+	spdlog::set_default_logger(previous);
+	EXPECT_NE(log.str().find("Cannot parse the line 11"), std::string::npos) << log.str();
+}
@@ -0,0 +1,74 @@
+#include <core/common>
+#include <neural/dataset.hpp>
+#include <neural/dataset_deduplicator.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+/// 1000 lines of 10 repeated values and one line with the same input as the first but another output
+golxzn::neural::Dataset make_dataset(const golxzn::neural::Dataset::Layout layout) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::Dataset dataset{ layout };
+	for (golxzn::core::u32 line{}; line < 1000_u32; ++line) {
+		const auto value{ static_cast<golxzn::core::f32>(line % 10) };
+		dataset.append({ value, 1.0_f32 }, { value * 2.0_f32 });
+	}
+	dataset.append({ 0.0_f32, 1.0_f32 }, { 1.0_f32 });
+	return dataset;
+}
+
+} // anonymous namespace
+
+TEST(DatasetDeduplicatorTest, FindsMultiplicities) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::DatasetDeduplicator;
+
+	for (const auto layout : { Dataset::Layout::RowMajor, Dataset::Layout::ColumnMajor }) {
+		const auto dataset{ make_dataset(layout) };
+		const auto result{ DatasetDeduplicator::find(dataset, 4) };
+		ASSERT_EQ(result.unique.size(), 11);
+		EXPECT_EQ(result.duplicates_count(), 990_u32);
+		for (golxzn::core::u32 i{}; i < 10_u32; ++i) {
+			EXPECT_EQ(result.unique[i], i);
+			EXPECT_EQ(result.multiplicities[i], 100_u32);
+		}
+		EXPECT_EQ(result.unique.back(), 1000_u32);
+		EXPECT_EQ(result.multiplicities.back(), 1_u32);
+		EXPECT_DOUBLE_EQ(result.weights().front(), 100.0);
+	}
+}
+
+TEST(DatasetDeduplicatorTest, SameResultForAnyThreadsCount) {
+	using golxzn::neural::Dataset;
+	using golxzn::neural::DatasetDeduplicator;
+
+	const auto dataset{ make_dataset(Dataset::Layout::RowMajor) };
+	const auto expected{ DatasetDeduplicator::find(dataset, 1) };
+	for (const golxzn::core::u32 threads : { 2, 3, 8 }) {
+		const auto result{ DatasetDeduplicator::find(dataset, threads) };
+		EXPECT_EQ(result.unique, expected.unique);
+		EXPECT_EQ(result.multiplicities, expected.multiplicities);
+	}
+}
+
+TEST(DatasetDeduplicatorTest, Deduplicate) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::DatasetDeduplicator;
+
+	for (const auto layout : { Dataset::Layout::RowMajor, Dataset::Layout::ColumnMajor }) {
+		auto dataset{ make_dataset(layout) };
+		const auto expected{ DatasetDeduplicator::find(dataset, 4) };
+		const auto removed{ DatasetDeduplicator::deduplicate(dataset, 2) };
+		EXPECT_EQ(removed.unique, expected.unique);
+		ASSERT_EQ(dataset.lines_count(), 11_u32);
+		EXPECT_EQ(dataset.layout(), layout);
+		EXPECT_DOUBLE_EQ(dataset.at(3, 0), 3.0);
+		EXPECT_DOUBLE_EQ(dataset.at(3, 2), 6.0);
+		EXPECT_DOUBLE_EQ(dataset.at(10, 2), 1.0);
+
+		EXPECT_EQ(DatasetDeduplicator::find(dataset).duplicates_count(), 0_u32);
+	}
+}
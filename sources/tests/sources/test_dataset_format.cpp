@@ -0,0 +1,72 @@
+#include <core/common>
+#include <neural/dataset_format.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+golxzn::neural::Dataset make_dataset() {
+	using namespace golxzn::types_literals;
+	golxzn::neural::Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 64_u32; ++line) {
+		const auto value{ static_cast<golxzn::core::f32>(line) };
+		dataset.append({ value * 0.25_f32, -value }, { value > 31.0_f32 ? 1.0_f32 : 0.0_f32 });
+	}
+	return dataset;
+}
+
+} // anonymous namespace
+
+TEST(DatasetFormatTest, RoundTripAllTypes) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::DatasetFormat;
+
+	const auto dataset{ make_dataset() };
+	const std::array<std::pair<DatasetFormat::ElementType, golxzn::core::f32>, 5> types{ {
+		{ DatasetFormat::ElementType::F64, 0.0_f32 },
+		{ DatasetFormat::ElementType::F32, 1e-6_f32 },
+		{ DatasetFormat::ElementType::F16, 0.05_f32 },
+		{ DatasetFormat::ElementType::BF16, 0.25_f32 },
+		{ DatasetFormat::ElementType::U8, 0.13_f32 },
+	} };
+
+	for (const auto &[type, tolerance] : types) {
+		const auto content{ DatasetFormat::encode(dataset, type) };
+		ASSERT_FALSE(content.empty());
+
+		const auto header{ DatasetFormat::read_header(content) };
+		ASSERT_TRUE(header.has_value());
+		EXPECT_EQ(header->type, type);
+		EXPECT_EQ(header->lines_count, 64_u64);
+		EXPECT_EQ(header->data_offset % DatasetFormat::default_alignment, 0_u32);
+		EXPECT_EQ(content.size(), header->data_offset + 64 * 3 * DatasetFormat::element_size(type));
+
+		const auto decoded{ DatasetFormat::decode(content) };
+		ASSERT_EQ(decoded.lines_count(), 64_u32);
+		for (golxzn::core::u32 line{}; line < decoded.lines_count(); ++line) {
+			for (golxzn::core::u32 column{}; column < decoded.line_size(); ++column) {
+				EXPECT_NEAR(decoded.at(line, column), dataset.at(line, column), tolerance);
+			}
+		}
+	}
+}
+
+TEST(DatasetFormatTest, RejectsInvalid) {
+	using golxzn::neural::DatasetFormat;
+
+	auto content{ DatasetFormat::encode(make_dataset(), DatasetFormat::ElementType::F16) };
+	EXPECT_TRUE(DatasetFormat::is_formatted(content));
+	content.resize(content.size() - 1);
+	EXPECT_FALSE(DatasetFormat::read_header(content).has_value());
+	EXPECT_FALSE(DatasetFormat::is_formatted(std::vector<golxzn::core::byte>(64)));
+}
+
+TEST(DatasetFormatTest, RejectsOverflowingLinesCount) {
+	using golxzn::neural::DatasetFormat;
+
+	/// lines_count * line bytes wraps around to the small size
+	auto content{ DatasetFormat::encode(make_dataset(), DatasetFormat::ElementType::F64) };
+	const golxzn::core::u64 lines_count{ (1ULL << 63) / 3 + 1 };
+	std::memcpy(content.data() + 16, &lines_count, sizeof(lines_count));
+	EXPECT_FALSE(DatasetFormat::read_header(content).has_value());
+	EXPECT_FALSE(DatasetFormat::read_header(std::span{ content }.first(DatasetFormat::header_size), content.size()).has_value());
+}
@@ -0,0 +1,104 @@
+#include <core/common>
+#include <core/resources/manager.hpp>
+#include <neural/dataset_stream.hpp>
+#include <gtest/gtest.h>
+
+TEST(DatasetStreamTest, ReadsByChunks) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::DatasetStream;
+
+	DatasetStream stream{ "res://assets/tests/dataset_test_counts.bin", DatasetStream::Settings{
+		.chunk_lines = 2,
+		.buffers_count = 2,
+		.statistics = nullptr,
+	} };
+	ASSERT_TRUE(stream.is_open());
+	EXPECT_EQ(stream.get_input_count(), 2_u32);
+	EXPECT_EQ(stream.get_output_count(), 1_u32);
+
+	for (int epoch{}; epoch < 2; ++epoch) {
+		std::vector<golxzn::core::u32> sizes;
+		for (auto chunk{ stream.next() }; !chunk.empty(); chunk = stream.next()) {
+			sizes.push_back(chunk.lines_count());
+			for (golxzn::core::u32 line{}; line < chunk.lines_count(); ++line) {
+				EXPECT_DOUBLE_EQ(chunk.input(line)[0], 1.4);
+				EXPECT_DOUBLE_EQ(chunk.input(line)[1], -1.8);
+				EXPECT_DOUBLE_EQ(chunk.output(line)[0], 1.0);
+			}
+		}
+		EXPECT_EQ(sizes, (std::vector{ 2_u32, 2_u32, 1_u32 }));
+		stream.restart();
+	}
+
+	const auto metrics{ stream.metrics() };
+	EXPECT_GE(metrics.chunks, 6);
+	EXPECT_GE(metrics.bytes_read, 2 * 5 * 3 * sizeof(golxzn::core::f32));
+}
+
+TEST(DatasetStreamTest, Headerless) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::DatasetStream;
+
+	DatasetStream stream{ "res://assets/tests/dataset_test.bin", 2_u32, 1_u32, DatasetStream::Settings{} };
+	const auto chunk{ stream.next() };
+	EXPECT_EQ(chunk.lines_count(), 5_u32);
+	EXPECT_TRUE(stream.next().empty());
+	EXPECT_TRUE(stream.next().empty());
+}
+
+TEST(DatasetStreamTest, FormattedFile) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::DatasetStream;
+	using golxzn::neural::DatasetFormat;
+	namespace fs = golxzn::core::fs;
+
+	golxzn::neural::Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 5_u32; ++line) {
+		dataset.append({ static_cast<golxzn::core::f32>(line), -1.0_f32 }, { 0.5_f32 });
+	}
+	auto content{ DatasetFormat::encode(dataset, DatasetFormat::ElementType::F16) };
+	content.resize(content.size() + 3); // the trailing bytes aren't the lines
+
+	const auto path{ golxzn::core::resources::manager::resolve("user://dataset_stream_test.gtds") };
+	fs::create_directories(path.parent_path());
+	fs::ofstream{ path, std::ios::binary }.write(reinterpret_cast<const char *>(content.data()),
+		static_cast<std::streamsize>(content.size()));
+
+	{
+		DatasetStream stream{ "user://dataset_stream_test.gtds", DatasetStream::Settings{
+			.chunk_lines = 2,
+			.buffers_count = 2,
+			.statistics = nullptr,
+		} };
+		ASSERT_TRUE(stream.is_open());
+		EXPECT_EQ(stream.get_input_count(), 2_u32);
+		EXPECT_EQ(stream.get_output_count(), 1_u32);
+
+		golxzn::core::u32 lines{};
+		for (auto chunk{ stream.next() }; !chunk.empty(); chunk = stream.next()) {
+			for (golxzn::core::u32 line{}; line < chunk.lines_count(); ++line, ++lines) {
+				EXPECT_DOUBLE_EQ(chunk.input(line)[0], static_cast<golxzn::core::f32>(lines));
+				EXPECT_DOUBLE_EQ(chunk.input(line)[1], -1.0);
+				EXPECT_DOUBLE_EQ(chunk.output(line)[0], 0.5);
+			}
+		}
+		EXPECT_EQ(lines, 5_u32);
+	}
+
+	/// The truncated file is rejected instead of reading the garbage
+	content.resize(content.size() - 8);
+	fs::ofstream{ path, std::ios::binary | std::ios::trunc }.write(reinterpret_cast<const char *>(content.data()),
+		static_cast<std::streamsize>(content.size()));
+	EXPECT_FALSE(DatasetStream{ "user://dataset_stream_test.gtds" }.is_open());
+	fs::remove(path);
+}
+
+TEST(DatasetStreamTest, MissingFile) {
+	using golxzn::neural::DatasetStream;
+
+	DatasetStream stream{ "res://assets/tests/missing_dataset.bin", DatasetStream::Settings{} };
+	EXPECT_FALSE(stream.is_open());
+	EXPECT_TRUE(stream.next().empty());
+	stream.restart();
+	EXPECT_TRUE(stream.next().empty());
+}
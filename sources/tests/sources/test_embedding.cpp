@@ -0,0 +1,68 @@
+#include <core/common>
+#include <neural/embedding.hpp>
+#include <gtest/gtest.h>
+
+TEST(EmbeddingTest, GatherSumLookup) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::Embedding embedding{ 8_u32, 2_u32 };
+	EXPECT_EQ(embedding.vocabulary_size(), 8_u32);
+	EXPECT_EQ(embedding.dimension(), 2_u32);
+
+	auto first{ embedding.row(1_u32) };
+	first[0] = 1.0_f32;
+	first[1] = 2.0_f32;
+	auto second{ embedding.row(5_u32) };
+	second[0] = -1.0_f32;
+	second[1] = 0.5_f32;
+
+	const auto output{ embedding.lookup({ { 1_u32, 2.0_f32 }, { 5_u32, 1.0_f32 } }) };
+	ASSERT_EQ(output.size(), 2_u32);
+	EXPECT_DOUBLE_EQ(output.at(0), 1.0);
+	EXPECT_DOUBLE_EQ(output.at(1), 4.5);
+
+	EXPECT_TRUE(embedding.row(8_u32).empty());
+	const auto skipped{ embedding.lookup({ { 8_u32, 1.0_f32 } }) };
+	EXPECT_DOUBLE_EQ(skipped.at(0), 0.0);
+	EXPECT_DOUBLE_EQ(skipped.at(1), 0.0);
+}
+
+TEST(EmbeddingTest, SparseUpdateTouchesOnlyUsedRows) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::Embedding embedding{ 4_u32, 2_u32 };
+	const std::vector gradient{ 1.0_f32, -2.0_f32 };
+	embedding.update({ { 2_u32, 1.0_f32 } }, gradient, 0.5_f32);
+
+	for (golxzn::core::u32 index{}; index < embedding.vocabulary_size(); ++index) {
+		const auto row{ embedding.row(index) };
+		if (index == 2_u32) {
+			EXPECT_DOUBLE_EQ(row[0], -0.5);
+			EXPECT_DOUBLE_EQ(row[1], 1.0);
+		} else {
+			EXPECT_DOUBLE_EQ(row[0], 0.0);
+			EXPECT_DOUBLE_EQ(row[1], 0.0);
+		}
+	}
+}
+
+TEST(EmbeddingTest, HashedTextFeatures) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::Embedding embedding{ 1024_u32, 4_u32 };
+	const auto input{ embedding.make_input("  hello world\thello \n") };
+
+	const auto hello{ embedding.index_of("hello") };
+	const auto found{ std::ranges::find(input, hello, &golxzn::neural::Embedding::Feature::index) };
+	ASSERT_NE(found, std::end(input));
+	EXPECT_DOUBLE_EQ(found->value, 2.0);
+
+	const auto total{ std::accumulate(std::begin(input), std::end(input), 0.0_f32,
+		[](auto acc, const auto &feature) { return acc + feature.value; }) };
+	EXPECT_DOUBLE_EQ(total, 3.0);
+	EXPECT_TRUE(std::ranges::is_sorted(input, {}, &golxzn::neural::Embedding::Feature::index));
+	EXPECT_TRUE(embedding.make_input(" \t ").empty());
+
+	/// The index must not depend on the toolchain, otherwise the trained rows are lost
+	EXPECT_EQ(hello, 716);
+}
@@ -0,0 +1,48 @@
+#include <core/common>
+#include <neural/dataset.hpp>
+#include <neural/feature_statistics.hpp>
+#include <gtest/gtest.h>
+
+TEST(FeatureStatisticsTest, ParallelMatchesSequential) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Dataset;
+	using golxzn::neural::FeatureStatistics;
+
+	Dataset dataset;
+	for (golxzn::core::u32 line{}; line < 1001_u32; ++line) {
+		const auto value{ static_cast<golxzn::core::f32>(line) };
+		dataset.append({ 1e9_f32 + value, -2.0_f32 * value }, { static_cast<golxzn::core::f32>(line % 2) });
+	}
+
+	const auto statistics{ FeatureStatistics::compute(dataset, 4_u32) };
+	ASSERT_EQ(statistics.columns().size(), 3_u32);
+	const auto &first{ statistics.columns().at(0) };
+	EXPECT_EQ(first.count, 1001_u64);
+	EXPECT_NEAR(first.mean, 1e9 + 500.0, 1e-6);
+	EXPECT_NEAR(first.variance(), (1001.0 * 1001.0 - 1.0) / 12.0, 1e-6);
+	EXPECT_DOUBLE_EQ(first.min, 1e9);
+	EXPECT_DOUBLE_EQ(statistics.columns().at(1).max, 0.0);
+	EXPECT_DOUBLE_EQ(statistics.inverse_deviation(0), 1.0 / first.deviation());
+	EXPECT_DOUBLE_EQ(FeatureStatistics(2_u32, 1_u32).inverse_deviation(0), 1.0); // the constant column
+
+	FeatureStatistics sequential{ 2_u32, 1_u32 };
+	sequential.update(dataset.data());
+	EXPECT_NEAR(sequential.columns().at(1).variance(), statistics.columns().at(1).variance(), 1e-6);
+
+	dataset.set_layout(Dataset::Layout::ColumnMajor);
+	EXPECT_NEAR(FeatureStatistics::compute(dataset, 3_u32).columns().at(0).m2, first.m2, 1e-3);
+
+	dataset.standardize(statistics);
+	const auto standardized{ FeatureStatistics::compute(dataset) };
+	EXPECT_NEAR(standardized.columns().at(0).mean, 0.0, 1e-9);
+	EXPECT_NEAR(standardized.columns().at(1).variance(), 1.0, 1e-9);
+	EXPECT_DOUBLE_EQ(standardized.columns().at(2).max, 1.0);
+
+	const auto restored{ FeatureStatistics::deserialize(statistics.serialize()) };
+	ASSERT_EQ(restored.columns().size(), 3_u32);
+	EXPECT_DOUBLE_EQ(restored.columns().at(0).m2, first.m2);
+
+	std::vector input{ 1e9_f32 + 500.0_f32, 0.0_f32 };
+	restored.standardize_input(input);
+	EXPECT_NEAR(input.at(0), 0.0, 1e-9);
+}
@@ -0,0 +1,103 @@
+#include <core/common>
+#include <neural/network.hpp>
+#include <neural/activation/sigmoid_function.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+golxzn::core::sptr<golxzn::neural::Network> make_network() {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Layer;
+	using golxzn::neural::activation::SigmoidFunction;
+
+	auto network{ std::make_shared<golxzn::neural::Network>() };
+	network->add_layer({ Layer::Type::Input, 2_u32, nullptr });
+	network->add_layer({ Layer::Type::Hidden, 2_u32, std::make_shared<SigmoidFunction>() });
+	network->add_layer({ Layer::Type::Output, 1_u32, std::make_shared<SigmoidFunction>() });
+	network->generate_values(true);
+	return network;
+}
+
+} // anonymous namespace
+
+TEST(GradientTest, FlatLayout) {
+	const auto network{ make_network() };
+	golxzn::neural::Gradient gradient{ *network };
+
+	/// 2 inputs + bias -> 2 hidden + bias -> 1 output
+	ASSERT_EQ(gradient.layers_count(), 3);
+	EXPECT_EQ(gradient.neurons_count(0), 3);
+	EXPECT_EQ(gradient.neurons_count(1), 3);
+	EXPECT_EQ(gradient.neurons_count(2), 1);
+	EXPECT_EQ(gradient.size(), 2 * 3 + 3);
+	EXPECT_EQ(gradient.output().size(), 1);
+
+	EXPECT_TRUE(gradient.layer(0).empty());
+	EXPECT_EQ(gradient.layer(1).size(), 6);
+	EXPECT_EQ(gradient.layer(2).size(), 3);
+	EXPECT_EQ(gradient.neuron(1, 0).size(), 3);
+	EXPECT_TRUE(gradient.neuron(1, 2).empty()); // bias has no previous edges
+
+	/// Layer by layer, neuron by neuron in the single buffer
+	const auto values{ gradient.values() };
+	EXPECT_EQ(gradient.layer(1).data(), values.data());
+	EXPECT_EQ(gradient.neuron(1, 1).data(), values.data() + 3);
+	EXPECT_EQ(gradient.layer(2).data(), values.data() + 6);
+	EXPECT_EQ(gradient.layer(2).data(), gradient.neuron(2, 0).data());
+	EXPECT_TRUE(gradient.neuron(1, 3).empty());
+	EXPECT_TRUE(gradient.layer(3).empty());
+}
+
+TEST(GradientTest, ShiftBackWeightsRoundTrip) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::constants::learning_rate;
+
+	const auto network{ make_network() };
+	golxzn::neural::Gradient gradient{ *network };
+	const auto values{ gradient.values() };
+	for (size_t i{}; i < values.size(); ++i) {
+		values[i] = 0.01_f32 * static_cast<golxzn::core::f32>(i + 1);
+	}
+
+	/// The shift of neuron j from its previous edge i is the weight of the next edge j of neuron i
+	const auto before{ network->weights() };
+	network->shift_back_weights(gradient);
+	const auto after{ network->weights() };
+	for (golxzn::core::u32 layer{ 1 }; layer < gradient.layers_count(); ++layer) {
+		for (golxzn::core::u32 neuron{}; neuron < gradient.neurons_count(layer); ++neuron) {
+			const auto shifts{ gradient.neuron(layer, neuron) };
+			for (size_t previous{}; previous < shifts.size(); ++previous) {
+				EXPECT_NEAR(after[layer - 1][previous][neuron] - before[layer - 1][previous][neuron],
+					shifts[previous] * learning_rate, 1e-6);
+			}
+		}
+	}
+
+	/// The nested adapter gives the same layout and the same shifts
+	const auto nested{ gradient.to_nested() };
+	golxzn::neural::Gradient copy{ *network };
+	ASSERT_TRUE(copy.assign(nested));
+	EXPECT_TRUE(std::ranges::equal(copy.values(), gradient.values()));
+
+	network->shift_back_weights(nested);
+	const auto twice{ network->weights() };
+	for (size_t layer{}; layer < twice.size(); ++layer) {
+		for (size_t neuron{}; neuron < twice[layer].size(); ++neuron) {
+			for (size_t edge{}; edge < twice[layer][neuron].size(); ++edge) {
+				EXPECT_NEAR(twice[layer][neuron][edge] - after[layer][neuron][edge],
+					after[layer][neuron][edge] - before[layer][neuron][edge], 1e-6);
+			}
+		}
+	}
+
+	/// The wrong layout is rejected instead of throwing
+	auto broken{ nested };
+	broken[1][0].pop_back();
+	EXPECT_FALSE(copy.assign(broken));
+	network->shift_back_weights(broken);
+	EXPECT_EQ(network->weights(), twice);
+
+	const auto hidden{ network->layers().at(1) };
+	const std::vector short_shifts(gradient.layer(1).size() - 1, 0.0_f32);
+	EXPECT_FALSE(hidden->shift_back_weights(std::span<const golxzn::core::f32>{ short_shifts }));
+}
@@ -0,0 +1,91 @@
+#include <core/common>
+#include <neural/header_exporter.hpp>
+#include <neural/static_network.hpp>
+#include <neural/network.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+// The same layout as HeaderExporter generates
+struct tiny_model {
+	static constexpr std::array<golxzn::core::u32, 3> topology{ 2, 2, 1 };
+	static constexpr std::array<std::string_view, 3> activations{ "linear", "relu", "sigmoid" };
+	static constexpr std::array<golxzn::core::u32, 2> offsets{ 0, 6 };
+	alignas(64) static constexpr std::array<golxzn::core::f32, 9> weights{
+		1, -1,
+		2, 0.5,
+		0, -3,
+		1, 2,
+		-1,
+	};
+};
+
+const golxzn::neural::HeaderExporter::Model tiny_description{
+	.name = "tiny_model",
+	.topology = { 2, 2, 1 },
+	.activations = { "linear", "relu", "sigmoid" },
+	.weights = { 1, -1, 2, 0.5, 0, -3, 1, 2, -1 },
+};
+
+} // anonymous namespace
+
+TEST(HeaderExporterTest, Write) {
+	using golxzn::neural::HeaderExporter;
+
+	const auto header{ HeaderExporter::write(tiny_description) };
+	ASSERT_FALSE(header.empty());
+	EXPECT_NE(header.find("namespace golxzn::neural::models {"), std::string::npos);
+	EXPECT_NE(header.find("struct tiny_model {"), std::string::npos);
+	EXPECT_NE(header.find("std::array<core::u32, 3> topology{ 2, 2, 1 };"), std::string::npos);
+	EXPECT_NE(header.find("activations{ \"linear\", \"relu\", \"sigmoid\" };"), std::string::npos);
+	EXPECT_NE(header.find("std::array<core::u32, 2> offsets{ 0, 6 };"), std::string::npos);
+	EXPECT_NE(header.find("alignas(64) static constexpr std::array<core::f32, 9> weights{"), std::string::npos);
+	EXPECT_NE(header.find("1, -1, 2, 0.5, 0, -3, 1, 2,"), std::string::npos);
+
+	auto invalid{ tiny_description };
+	invalid.weights.pop_back();
+	EXPECT_TRUE(HeaderExporter::write(invalid).empty());
+	invalid = tiny_description;
+	invalid.name = "1tiny";
+	EXPECT_TRUE(HeaderExporter::write(invalid).empty());
+	invalid = tiny_description;
+	invalid.activations.at(1) = "tanh";
+	EXPECT_TRUE(HeaderExporter::write(invalid).empty());
+}
+
+TEST(HeaderExporterTest, WriteNetwork) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Layer;
+	using golxzn::neural::HeaderExporter;
+	using golxzn::neural::activation::ReLUFunction;
+	using golxzn::neural::activation::SigmoidFunction;
+
+	auto network{ std::make_shared<golxzn::neural::Network>() };
+	network->add_layer({ Layer::Type::Input, 2_u32, nullptr });
+	network->add_layer({ Layer::Type::Hidden, 2_u32, std::make_shared<ReLUFunction>() });
+	network->add_layer({ Layer::Type::Output, 1_u32, std::make_shared<SigmoidFunction>() });
+	network->generate_values(false);
+	network->alter_weights({
+		{ { 1.0_f32, -1.0_f32 }, { 2.0_f32, 0.5_f32 }, { 0.0_f32, -3.0_f32 } },
+		{ { 1.0_f32 }, { 2.0_f32 }, { -1.0_f32 } },
+		{ {} },
+	});
+
+	/// The input layer has no activation, so it's exported as the linear one
+	const auto header{ HeaderExporter::write(*network, "tiny_model") };
+	ASSERT_FALSE(header.empty());
+	EXPECT_NE(header.find("std::array<core::u32, 3> topology{ 2, 2, 1 };"), std::string::npos);
+	EXPECT_NE(header.find("activations{ \"linear\", \"relu\", \"sigmoid\" };"), std::string::npos);
+	EXPECT_NE(header.find("std::array<core::u32, 2> offsets{ 0, 6 };"), std::string::npos);
+	EXPECT_NE(header.find("std::array<core::f32, 9> weights{"), std::string::npos);
+	EXPECT_NE(header.find("1, -1, 2, 0.5, 0, -3, 1, 2,"), std::string::npos);
+}
+
+TEST(HeaderExporterTest, StaticPredict) {
+	using namespace golxzn::types_literals;
+
+	const auto output{ golxzn::neural::StaticNetwork::predict<tiny_model>({ 1.0_f32, 2.0_f32 }) };
+	// hidden: relu(1 * 1 + 2 * 2 + 0) = 5, relu(1 * -1 + 2 * 0.5 - 3) = 0
+	// output: sigmoid(5 * 1 + 0 * 2 - 1)
+	EXPECT_DOUBLE_EQ(output.at(0), 1.0 / (1.0 + std::exp(-4.0)));
+}
@@ -0,0 +1,280 @@
+#include <core/common>
+#include <core/resources/manager.hpp>
+#include <core/resources/http_client.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <winsock2.h>
+#	include <ws2tcpip.h>
+#else
+#	include <unistd.h>
+#	include <sys/socket.h>
+#	include <netinet/in.h>
+#	include <arpa/inet.h>
+#endif
+
+namespace {
+
+using golxzn::core::byte;
+
+#if defined(_WIN32)
+using socket_t = SOCKET;
+constexpr socket_t invalid_socket{ INVALID_SOCKET };
+constexpr int shutdown_both{ SD_BOTH };
+constexpr int send_flags{ 0 };
+
+void close_socket(const socket_t socket) noexcept { ::closesocket(socket); }
+
+struct sockets_guard {
+	sockets_guard() { WSADATA data{}; WSAStartup(MAKEWORD(2, 2), &data); }
+	~sockets_guard() { WSACleanup(); }
+};
+#else
+using socket_t = int;
+constexpr socket_t invalid_socket{ -1 };
+constexpr int shutdown_both{ SHUT_RDWR };
+constexpr int send_flags{ MSG_NOSIGNAL };
+
+void close_socket(const socket_t socket) noexcept { ::close(socket); }
+
+struct sockets_guard {};
+#endif
+
+/** @brief The local stand-in of the artifact server. Each connection serves the requests until it's closed */
+class stand_in_server {
+public:
+	static constexpr size_t data_size{ 100000 };
+
+	stand_in_server() {
+		mSocket = ::socket(AF_INET, SOCK_STREAM, 0);
+		EXPECT_NE(mSocket, invalid_socket);
+		sockaddr_in address{};
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		::bind(mSocket, reinterpret_cast<sockaddr *>(&address), sizeof(address));
+		::listen(mSocket, 16);
+
+		socklen_t length{ sizeof(address) };
+		::getsockname(mSocket, reinterpret_cast<sockaddr *>(&address), &length);
+		mPort = ntohs(address.sin_port);
+
+		for (size_t i{}; i < data_size; ++i) {
+			mData.push_back(static_cast<char>('a' + i % 26));
+		}
+		mAcceptor = std::thread{ [this] { accept(); } };
+	}
+
+	~stand_in_server() {
+		::shutdown(mSocket, shutdown_both);
+		close_socket(mSocket);
+		mAcceptor.join();
+		{
+			std::lock_guard lock{ mMutex };
+			for (const auto client : mClients) ::shutdown(client, shutdown_both);
+		}
+		for (auto &connection : mConnections) connection.join();
+	}
+
+	std::string url(const std::string_view target) const {
+		return fmt::format("http://127.0.0.1:{}{}", mPort, target);
+	}
+
+	const std::string &data() const noexcept { return mData; }
+	std::string uploaded() const {
+		std::lock_guard lock{ mMutex };
+		return mUploaded;
+	}
+	int accepted() const noexcept { return mAccepted; }
+
+private:
+	sockets_guard mSockets;
+	socket_t mSocket{ invalid_socket };
+	golxzn::core::u16 mPort{};
+	std::string mData;
+	std::thread mAcceptor;
+	std::vector<std::thread> mConnections;
+	mutable std::mutex mMutex;
+	std::vector<socket_t> mClients;
+	std::string mUploaded;
+	std::atomic<int> mAccepted{};
+
+	void accept() {
+		for (;;) {
+			const auto client{ ::accept(mSocket, nullptr, nullptr) };
+			if (client == invalid_socket) return;
+
+			++mAccepted;
+			std::lock_guard lock{ mMutex };
+			mClients.push_back(client);
+			mConnections.emplace_back([this, client] { serve(client); close_socket(client); });
+		}
+	}
+
+	void serve(const socket_t client) {
+		std::string buffer;
+		char chunk[4096];
+		for (;;) {
+			size_t head_end{};
+			while ((head_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+				const auto received{ ::recv(client, chunk, static_cast<int>(sizeof(chunk)), 0) };
+				if (received <= 0) return;
+				buffer.append(chunk, static_cast<size_t>(received));
+			}
+			const auto head{ buffer.substr(0, head_end) };
+			buffer.erase(0, head_end + 4);
+
+			const auto method{ head.substr(0, head.find(' ')) };
+			const auto target_begin{ method.size() + 1 };
+			const auto target{ head.substr(target_begin, head.find(' ', target_begin) - target_begin) };
+
+			size_t content_length{};
+			if (const auto found{ head.find("Content-Length: ") }; found != std::string::npos) {
+				content_length = std::stoul(head.substr(found + 16));
+			}
+			while (buffer.size() < content_length) {
+				const auto received{ ::recv(client, chunk, static_cast<int>(sizeof(chunk)), 0) };
+				if (received <= 0) return;
+				buffer.append(chunk, static_cast<size_t>(received));
+			}
+			const auto body{ buffer.substr(0, content_length) };
+			buffer.erase(0, content_length);
+
+			if (!respond(client, method, target, head, body)) return;
+		}
+	}
+
+	bool respond(const socket_t client, const std::string &method, const std::string &target,
+			const std::string &head, const std::string &body) {
+		if (method == "PUT" && target == "/upload") {
+			{
+				std::lock_guard lock{ mMutex };
+				mUploaded = body;
+			}
+			return send(client, "HTTP/1.1 201 Created\r\nContent-Length: 0\r\n\r\n");
+		}
+		if (target == "/data") {
+			if (const auto found{ head.find("Range: bytes=") }; found != std::string::npos) {
+				const auto first{ std::stoul(head.substr(found + 13)) };
+				const auto dash{ head.find('-', found) };
+				const auto last{ std::isdigit(head[dash + 1]) ? std::stoul(head.substr(dash + 1)) : data_size - 1 };
+				const auto part{ mData.substr(first, last - first + 1) };
+				return send(client, fmt::format("HTTP/1.1 206 Partial Content\r\nContent-Length: {}\r\n"
+					"Content-Range: bytes {}-{}/{}\r\n\r\n{}", part.size(), first, last, data_size, part));
+			}
+			return send(client, fmt::format("HTTP/1.1 200 OK\r\nContent-Length: {}\r\n\r\n{}", mData.size(), mData));
+		}
+		if (target == "/chunked") {
+			std::string response{ "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n" };
+			for (size_t offset{}; offset < mData.size(); offset += 7000) {
+				const auto part{ mData.substr(offset, 7000) };
+				response += fmt::format("{:x};ext=1\r\n{}\r\n", part.size(), part);
+			}
+			response += "0\r\nX-Trailer: done\r\n\r\n";
+			return send(client, response);
+		}
+		if (target == "/interim") {
+			return send(client, "HTTP/1.1 100 Continue\r\n\r\n"
+				"HTTP/1.1 103 Early Hints\r\nLink: </data>; rel=preload\r\n\r\n"
+				"HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nfinal");
+		}
+		if (target == "/close") {
+			send(client, "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\nuntil close");
+			return false;
+		}
+		return send(client, "HTTP/1.1 404 Not Found\r\nContent-Length: 7\r\n\r\nmissing");
+	}
+
+	static bool send(const socket_t client, const std::string_view response) {
+		for (auto rest{ response }; !rest.empty();) {
+			const auto sent{ ::send(client, rest.data(), static_cast<int>(rest.size()), send_flags) };
+			if (sent <= 0) return false;
+			rest.remove_prefix(static_cast<size_t>(sent));
+		}
+		return true;
+	}
+};
+
+} // anonymous namespace
+
+TEST(HttpClientTest, KeepAliveChunkedAndRange) {
+	using golxzn::core::resources::http_client;
+	stand_in_server server;
+	{
+		http_client client;
+
+		const auto full{ client.get(server.url("/data")) };
+		ASSERT_EQ(full.status, 200);
+		EXPECT_EQ(std::string(std::begin(full.body), std::end(full.body)), server.data());
+
+		/// The chunked body is streamed into the sink
+		std::string streamed;
+		size_t pieces{};
+		const auto chunked{ client.get(server.url("/chunked"), [&](std::span<const byte> piece) {
+			streamed.append(reinterpret_cast<const char *>(piece.data()), piece.size());
+			++pieces;
+			return true;
+		}) };
+		EXPECT_EQ(chunked.status, 200);
+		EXPECT_TRUE(chunked.body.empty());
+		EXPECT_EQ(chunked.body_size, server.data().size());
+		EXPECT_EQ(streamed, server.data());
+		EXPECT_GT(pieces, 1);
+
+		/// Resume the download from the received size
+		const auto resumed{ client.get(server.url("/data"), http_client::range{ 99990, std::nullopt }) };
+		EXPECT_EQ(resumed.status, 206);
+		EXPECT_EQ(std::string(std::begin(resumed.body), std::end(resumed.body)), server.data().substr(99990));
+		EXPECT_EQ(resumed.header("content-range"), "bytes 99990-99999/100000");
+
+		const auto missing{ client.get(server.url("/missing")) };
+		EXPECT_EQ(missing.status, 404);
+		EXPECT_FALSE(missing.ok());
+
+		/// Everything above went through the single kept alive connection
+		EXPECT_EQ(server.accepted(), 1);
+		EXPECT_EQ(client.statistics().connections_reused, 3);
+
+		const auto closed{ client.get(server.url("/close")) };
+		EXPECT_EQ(std::string(std::begin(closed.body), std::end(closed.body)), "until close");
+		EXPECT_EQ(client.get(server.url("/missing")).status, 404);
+		EXPECT_EQ(server.accepted(), 2);
+
+		const std::vector<std::string> urls(8, server.url("/data"));
+		const auto responses{ client.get_all(urls) };
+		ASSERT_EQ(responses.size(), urls.size());
+		for (const auto &response : responses) {
+			EXPECT_EQ(response.body.size(), stand_in_server::data_size);
+		}
+		EXPECT_LE(server.accepted(), 2 + 4);
+	}
+}
+
+TEST(HttpClientTest, ManagerHandlesHttpURL) {
+	using golxzn::core::resources::manager;
+	stand_in_server server;
+
+	EXPECT_EQ(manager::load_string(server.url("/data")), server.data());
+	EXPECT_TRUE(manager::save_string(server.url("/upload"), "checkpoint"));
+	EXPECT_EQ(server.uploaded(), "checkpoint");
+	EXPECT_TRUE(manager::load_binary(server.url("/missing")).empty());
+}
+
+TEST(HttpClientTest, SkipsInterimResponses) {
+	using golxzn::core::resources::http_client;
+	stand_in_server server;
+	http_client client;
+
+	const auto response{ client.get(server.url("/interim")) };
+	EXPECT_EQ(response.status, 200);
+	EXPECT_EQ(std::string(std::begin(response.body), std::end(response.body)), "final");
+	EXPECT_FALSE(response.header("Link").has_value());
+
+	/// The connection is still in sync for the next request
+	EXPECT_EQ(client.get(server.url("/missing")).status, 404);
+	EXPECT_EQ(server.accepted(), 1);
+}
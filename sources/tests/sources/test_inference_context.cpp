@@ -0,0 +1,74 @@
+#include <thread>
+#include <core/common>
+#include <neural/inference_context.hpp>
+#include <neural/activation/linear_function.hpp>
+#include <neural/activation/relu_function.hpp>
+#include <neural/activation/sigmoid_function.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+golxzn::core::sptr<const golxzn::neural::SharedWeights> make_weights() {
+	using namespace golxzn::neural;
+	return std::make_shared<const SharedWeights>(
+		std::vector<golxzn::core::u32>{ 2, 2, 1 },
+		std::vector<golxzn::core::sptr<activation::IFunction>>{
+			std::make_shared<activation::LinearFunction>(),
+			std::make_shared<activation::ReLUFunction>(),
+			std::make_shared<activation::SigmoidFunction>(),
+		},
+		std::vector<golxzn::core::f32>{ 1, -1, 2, 0.5, 0, -3, 1, 2, -1 }
+	);
+}
+
+} // anonymous namespace
+
+TEST(InferenceContextTest, Predict) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::InferenceContext context{ make_weights() };
+	const auto output{ context.predict(std::vector{ 1.0_f32, 2.0_f32 }) };
+	ASSERT_EQ(output.size(), 1_u32);
+	EXPECT_DOUBLE_EQ(output.at(0), 1.0 / (1.0 + std::exp(-4.0)));
+
+	EXPECT_TRUE(context.predict(std::vector{ 1.0_f32 }).empty());
+}
+
+TEST(InferenceContextTest, SharedBetweenThreads) {
+	using namespace golxzn::types_literals;
+
+	const auto weights{ make_weights() };
+	std::vector<golxzn::core::f32> results(4);
+	std::vector<std::thread> workers;
+	for (size_t id{}; id < results.size(); ++id) {
+		workers.emplace_back([&weights, &results, id] {
+			golxzn::neural::InferenceContext context{ weights };
+			for (int i{}; i < 1000; ++i) {
+				results[id] = context.predict(std::vector{ 1.0_f32, 2.0_f32 }).at(0);
+			}
+		});
+	}
+	for (auto &worker : workers) worker.join();
+
+	for (const auto result : results) {
+		EXPECT_DOUBLE_EQ(result, 1.0 / (1.0 + std::exp(-4.0)));
+	}
+	EXPECT_EQ(weights.use_count(), 1);
+}
+
+TEST(InferenceContextTest, PredictBatch) {
+	using namespace golxzn::types_literals;
+
+	golxzn::neural::InferenceContext context{ make_weights() };
+	const std::vector inputs{ 1.0_f32, 2.0_f32, 0.0_f32, 0.0_f32, -1.0_f32, 3.0_f32 };
+	const auto outputs{ context.predict_batch(inputs, 3_u32) };
+	ASSERT_EQ(outputs.size(), 3_u32);
+
+	const auto expected{ [&](const golxzn::core::f32 a, const golxzn::core::f32 b) {
+		golxzn::neural::InferenceContext single{ context.weights() };
+		return single.predict(std::vector{ a, b }).at(0);
+	} };
+	EXPECT_DOUBLE_EQ(outputs[0], expected(1.0_f32, 2.0_f32));
+	EXPECT_DOUBLE_EQ(outputs[1], expected(0.0_f32, 0.0_f32));
+	EXPECT_DOUBLE_EQ(outputs[2], expected(-1.0_f32, 3.0_f32));
+}
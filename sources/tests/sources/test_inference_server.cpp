@@ -0,0 +1,64 @@
+#include <core/common>
+#include <bot/inference_server.hpp>
+#include <neural/activation/linear_function.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+golxzn::core::sptr<const golxzn::neural::SharedWeights> make_sum_weights() {
+	using namespace golxzn::neural;
+	const auto linear{ std::make_shared<activation::LinearFunction>() };
+	// out = in[0] + 2 * in[1] + 1
+	return std::make_shared<const SharedWeights>(
+		std::vector<golxzn::core::u32>{ 2, 1 },
+		std::vector<golxzn::core::sptr<activation::IFunction>>{ linear, linear },
+		std::vector<golxzn::core::f32>{ 1, 2, 1 }
+	);
+}
+
+} // anonymous namespace
+
+TEST(InferenceServerTest, BatchesConcurrentRequests) {
+	using namespace std::chrono_literals;
+	using golxzn::bot::InferenceServer;
+
+	/// The deadline is never reached, so only the full batches are taken
+	InferenceServer server{ make_sum_weights(), InferenceServer::Settings{
+		.max_batch_size = 8,
+		.max_wait = 1h,
+		.workers_count = 1,
+		.max_queue_depth = 4096,
+	} };
+
+	std::vector<std::future<InferenceServer::result_t>> futures;
+	for (int i{}; i < 16; ++i) {
+		futures.emplace_back(server.submit({ static_cast<golxzn::core::f32>(i), 1.0 }));
+	}
+	for (int i{}; i < 16; ++i) {
+		const auto result{ futures[i].get() };
+		ASSERT_EQ(result.size(), 1);
+		EXPECT_DOUBLE_EQ(result.front(), i + 3.0);
+	}
+
+	const auto metrics{ server.metrics() };
+	EXPECT_EQ(metrics.requests, 16);
+	EXPECT_EQ(metrics.rejected, 0);
+	EXPECT_EQ(metrics.queue_depth, 0);
+	EXPECT_EQ(metrics.batches, 2);
+	EXPECT_EQ(metrics.full_batches, 2);
+	EXPECT_DOUBLE_EQ(metrics.average_batch_size, 8.0);
+}
+
+TEST(InferenceServerTest, RejectsInvalidAndStopped) {
+	using golxzn::bot::InferenceServer;
+
+	InferenceServer server{ make_sum_weights() };
+	EXPECT_TRUE(server.submit({ 1.0 }).get().empty());
+
+	auto pending{ server.submit({ 1.0, 1.0 }) };
+	server.stop();
+	EXPECT_FALSE(server.running());
+	EXPECT_DOUBLE_EQ(pending.get().front(), 4.0);
+	EXPECT_TRUE(server.submit({ 1.0, 1.0 }).get().empty());
+	EXPECT_EQ(server.metrics().rejected, 1);
+}
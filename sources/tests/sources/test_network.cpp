@@ -0,0 +1,54 @@
+#include <core/common>
+#include <neural/network.hpp>
+#include <neural/activation/linear_function.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+/// 2 inputs -> 2 hidden -> 1 output, all linear, with the known weights
+golxzn::core::sptr<golxzn::neural::Network> make_network() {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Layer;
+	using golxzn::neural::activation::LinearFunction;
+
+	auto network{ std::make_shared<golxzn::neural::Network>() };
+	network->add_layer({ Layer::Type::Input, 2_u32, nullptr });
+	network->add_layer({ Layer::Type::Hidden, 2_u32, std::make_shared<LinearFunction>() });
+	network->add_layer({ Layer::Type::Output, 1_u32, std::make_shared<LinearFunction>() });
+	network->generate_values(false);
+	network->alter_weights({
+		{ { 1.0_f32, 2.0_f32 }, { 3.0_f32, -1.0_f32 }, { 0.5_f32, 0.25_f32 } },
+		{ { 2.0_f32 }, { 4.0_f32 }, { -1.0_f32 } },
+		{ {} },
+	});
+	return network;
+}
+
+} // anonymous namespace
+
+TEST(NetworkTest, BuildsLayersOwnedByPointers) {
+	using namespace golxzn::types_literals;
+
+	const auto network{ make_network() };
+	const auto layers{ network->layers() };
+	ASSERT_EQ(layers.size(), 3);
+	EXPECT_EQ(layers.at(0)->neuron_count(), 3_u32); // 2 inputs + bias
+	EXPECT_EQ(layers.at(1)->neuron_count(), 3_u32); // 2 hidden + bias
+	EXPECT_EQ(layers.at(2)->neuron_count(), 1_u32);
+	EXPECT_EQ(layers.at(1)->network(), network);
+	EXPECT_EQ(network->weights().at(0).at(1), (std::vector{ 3.0, -1.0 }));
+}
+
+TEST(NetworkTest, PredictsLayerByLayer) {
+	using namespace golxzn::types_literals;
+
+	/// hidden = (1 * 1 + 2 * 3 + 0.5, 1 * 2 - 2 * 1 + 0.25) = (7.5, 0.25)
+	/// output = 7.5 * 2 + 0.25 * 4 - 1 = 15
+	const auto network{ make_network() };
+	const std::vector input{ 1.0_f32, 2.0_f32 };
+	EXPECT_EQ(network->predict(input), std::vector{ 15.0_f32 });
+
+	/// The accumulators are reset, so the same input gives the same output
+	EXPECT_EQ(network->predict(input), std::vector{ 15.0_f32 });
+	EXPECT_EQ(network->predict({ 0.0_f32, 0.0_f32 }), std::vector{ 0.5_f32 * 2.0_f32 + 0.25_f32 * 4.0_f32 - 1.0_f32 });
+}
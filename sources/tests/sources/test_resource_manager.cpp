@@ -0,0 +1,291 @@
+#include <core/common>
+#include <core/resources/manager.hpp>
+#include <gtest/gtest.h>
+
+TEST(ResourceManagerTest, MapMatchesLoad) {
+	using golxzn::core::resources::manager;
+	static constexpr std::string_view file{ "res://assets/tests/basic_test.ini" };
+
+	const auto loaded{ manager::load_binary(file) };
+	ASSERT_FALSE(loaded.empty());
+
+	const auto view{ manager::map(file) };
+	ASSERT_FALSE(view.empty());
+	EXPECT_TRUE(view.is_mapped());
+	EXPECT_TRUE(std::ranges::equal(view.data(), loaded));
+	EXPECT_EQ(view.as_string(), manager::load_string(file));
+
+	/// The copies share the mapping
+	auto copy{ view };
+	EXPECT_EQ(copy.data().data(), view.data().data());
+	copy.reset();
+	EXPECT_TRUE(copy.empty());
+	EXPECT_FALSE(view.empty());
+
+	EXPECT_TRUE(manager::map("res://assets/tests/missing.bin").empty());
+	EXPECT_TRUE(manager::map("unknown://file").empty());
+}
+
+TEST(ResourceManagerTest, CacheHitsAndInvalidates) {
+	using golxzn::core::resources::manager;
+	static constexpr std::string_view file{ "res://assets/tests/cache_test.bin" };
+
+	manager::clear_cache();
+	manager::set_cache_budget(manager::DefaultCacheBudget);
+	ASSERT_TRUE(manager::save_string(file, "first"));
+
+	const auto before{ manager::cache_statistics() };
+	const auto first{ manager::load_shared(file) };
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(manager::load_shared(file), first);
+	EXPECT_EQ(manager::load_string(file), "first");
+
+	auto stats{ manager::cache_statistics() };
+	EXPECT_EQ(stats.misses - before.misses, 1);
+	EXPECT_EQ(stats.hits - before.hits, 2);
+	EXPECT_EQ(stats.entries, 1);
+	EXPECT_EQ(stats.used, 5);
+
+	/// Saving drops the entry, the shared buffer stays alive
+	ASSERT_TRUE(manager::save_string(file, "second!"));
+	EXPECT_EQ(manager::load_string(file), "second!");
+	EXPECT_EQ(std::string(std::begin(*first), std::end(*first)), "first");
+
+	/// The budget evicts the least recently used entries
+	manager::set_cache_budget(4);
+	stats = manager::cache_statistics();
+	EXPECT_EQ(stats.entries, 0);
+	EXPECT_GE(stats.evictions, 1);
+
+	/// The file above the budget is read directly without looking into the cache
+	EXPECT_EQ(manager::load_string(file), "second!");
+	EXPECT_EQ(manager::cache_statistics().entries, 0);
+	EXPECT_EQ(manager::cache_statistics().misses, stats.misses);
+
+	manager::set_cache_budget(manager::DefaultCacheBudget);
+	golxzn::core::fs::remove(manager::resolve(file));
+	EXPECT_EQ(manager::load_shared(file), nullptr);
+}
+
+TEST(ResourceManagerTest, AsyncLoadAndSave) {
+	using golxzn::core::byte;
+	using golxzn::core::resources::manager;
+
+	std::vector<std::string> files;
+	std::vector<std::future<bool>> saved;
+	for (int i{}; i < 8; ++i) {
+		files.emplace_back(fmt::format("res://assets/tests/async_test_{}.bin", i));
+		saved.emplace_back(manager::save_binary_async(files.back(), std::vector<byte>(i + 1, static_cast<byte>(i))));
+	}
+	for (auto &result : saved) {
+		EXPECT_TRUE(result.get());
+	}
+
+	auto loaded{ manager::load_binary_async(std::span<const std::string>{ files }) };
+	ASSERT_EQ(loaded.size(), files.size());
+	for (size_t i{}; i < loaded.size(); ++i) {
+		EXPECT_EQ(loaded[i].get(), std::vector<byte>(i + 1, static_cast<byte>(i)));
+	}
+	EXPECT_EQ(manager::load_binary_async(files.front()).get(), std::vector<byte>{ 0 });
+
+	std::promise<size_t> callback_size;
+	manager::load_binary_async(files.back(), [&](std::vector<byte> content) {
+		callback_size.set_value(content.size());
+	});
+	EXPECT_EQ(callback_size.get_future().get(), files.size());
+	EXPECT_GE(manager::io_statistics().submitted, 11);
+
+	for (const auto &file : files) {
+		golxzn::core::fs::remove(manager::resolve(file));
+	}
+}
+
+TEST(ResourceManagerTest, AsyncJobsForwardExceptions) {
+	using golxzn::core::byte;
+	using golxzn::core::resources::manager;
+
+	ASSERT_TRUE(manager::register_scheme("throw://",
+		[](const std::string_view) -> std::vector<byte> { throw std::runtime_error{ "unreachable" }; },
+		[](const std::string_view, const byte *, const golxzn::core::u32, auto) -> bool {
+			throw std::runtime_error{ "unreachable" };
+		}
+	));
+	EXPECT_THROW(std::ignore = manager::load_binary_async("throw://load").get(), std::runtime_error);
+	EXPECT_THROW(std::ignore = manager::save_binary_async("throw://save", std::vector<byte>(1)).get(), std::runtime_error);
+
+	/// The thrown callbacks don't kill the I/O threads
+	manager::load_binary_async("throw://load", [](std::vector<byte>) {});
+	manager::load_binary_async("mem://missing", [](std::vector<byte>) { throw std::runtime_error{ "callback" }; });
+	EXPECT_TRUE(manager::unregister_scheme("throw://"));
+	EXPECT_TRUE(manager::save_binary_async("mem://after_throw", std::vector<byte>(1)).get());
+	EXPECT_TRUE(manager::memory().erase("mem://after_throw"));
+}
+
+TEST(ResourceManagerTest, WriteBehindAppendsAndAtomicRewrite) {
+	using golxzn::core::resources::manager;
+	static constexpr std::string_view file{ "res://assets/tests/write_behind_test.txt" };
+
+	ASSERT_TRUE(manager::save_string(file, "header\n"));
+
+	const auto before{ manager::write_statistics() };
+	manager::set_write_mode(manager::WriteMode::Append);
+	std::string expected{ "header\n" };
+	for (int i{}; i < 100; ++i) {
+		const auto record{ fmt::format("record {}\n", i) };
+		ASSERT_TRUE(manager::save_string(file, record));
+		expected += record;
+	}
+	manager::reset_write_mode();
+
+	/// Loading flushes the pending appends of the file
+	EXPECT_EQ(manager::load_string(file), expected);
+	const auto stats{ manager::write_statistics() };
+	EXPECT_EQ(stats.appends - before.appends, 100);
+	EXPECT_LT(stats.writes - before.writes, 10);
+	EXPECT_EQ(stats.pending_bytes, 0);
+
+	ASSERT_TRUE(manager::save_string(file, "replaced"));
+	EXPECT_EQ(manager::load_string(file), "replaced");
+
+	const auto path{ manager::resolve(file) };
+	for (const auto &entry : golxzn::core::fs::directory_iterator{ path.parent_path() }) {
+		EXPECT_NE(entry.path().extension(), ".tmp");
+	}
+	golxzn::core::fs::remove(path);
+}
+
+TEST(ResourceManagerTest, MountedPack) {
+	using golxzn::core::byte;
+	using golxzn::core::resources::manager;
+	using golxzn::core::resources::asset_pack;
+	namespace fs = golxzn::core::fs;
+
+	const auto directory{ fs::temp_directory_path() / "gtbot_pack_test" };
+	fs::create_directories(directory / "assets" / "nested");
+	{
+		fs::ofstream{ directory / "assets" / "text.txt" } << std::string(1000, 'a');
+		fs::ofstream{ directory / "assets" / "nested" / "raw.bin" } << "xyz";
+	}
+	const auto pack_path{ directory / "assets.pack" };
+	ASSERT_TRUE(asset_pack::build(directory / "assets", pack_path, asset_pack::settings{}));
+
+	const asset_pack pack{ pack_path };
+	ASSERT_TRUE(pack.is_open());
+	ASSERT_EQ(pack.entries_count(), 2);
+	EXPECT_EQ(pack.name(0), "nested/raw.bin");
+	EXPECT_LT(fs::file_size(pack_path), 300); // the text is compressed
+	EXPECT_FALSE(pack.contains("missing.txt"));
+
+	ASSERT_TRUE(manager::mount(pack_path));
+	EXPECT_EQ(manager::load_string("res://text.txt"), std::string(1000, 'a'));
+	EXPECT_EQ(manager::load_string("res://nested/raw.bin"), "xyz");
+
+	/// The stored entry is viewed right in the mapped pack
+	const auto view{ manager::map("res://nested/raw.bin") };
+	EXPECT_TRUE(view.is_mapped());
+	EXPECT_EQ(view.as_string(), "xyz");
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view.data().data()) % asset_pack::alignment, 0);
+	EXPECT_EQ(manager::map("res://text.txt").size(), 1000);
+
+	/// The files missing in the pack are still loaded from the assets directory
+	EXPECT_FALSE(manager::load_string("res://assets/tests/basic_test.ini").empty());
+
+	/// The saved file would be shadowed by the packed entry
+	EXPECT_FALSE(manager::save_string("res://text.txt", "b"));
+
+	manager::unmount();
+	EXPECT_TRUE(manager::load_string("res://text.txt").empty());
+
+	/// The corrupted index is rejected: the entry size wrapping around and the unsorted names
+	const auto corrupt{ [&](const size_t offset, const auto value) {
+		ASSERT_TRUE(asset_pack::build(directory / "assets", pack_path, asset_pack::settings{}));
+		fs::fstream file{ pack_path, std::ios::binary | std::ios::in | std::ios::out };
+		file.seekp(static_cast<std::streamoff>(offset));
+		file.write(reinterpret_cast<const char *>(&value), sizeof(value));
+	} };
+	corrupt(asset_pack::header_size + sizeof(golxzn::core::u64), ~golxzn::core::u64{});
+	EXPECT_EQ(asset_pack{ pack_path }.entries_count(), 0);
+	corrupt(asset_pack::header_size + 2 * asset_pack::entry_size, 'z'); // "zested/raw.bin" goes after "text.txt"
+	EXPECT_EQ(asset_pack{ pack_path }.entries_count(), 0);
+	fs::remove_all(directory);
+}
+
+TEST(ResourceManagerTest, MemorySchemeAndRegistry) {
+	using golxzn::core::byte;
+	using golxzn::core::resources::manager;
+
+	ASSERT_TRUE(manager::save_string("mem://artifacts/state", "one"));
+	manager::set_write_mode(manager::WriteMode::Append);
+	ASSERT_TRUE(manager::save_string("mem://artifacts/state", "+two"));
+	manager::reset_write_mode();
+	EXPECT_EQ(manager::load_string("mem://artifacts/state"), "one+two");
+
+	/// The blob is shared without copying
+	const auto shared{ manager::load_shared("mem://artifacts/state") };
+	ASSERT_NE(shared, nullptr);
+	EXPECT_EQ(manager::map("mem://artifacts/state").data().data(), shared->data());
+
+	/// The appends don't change the blob held by the reader
+	manager::set_write_mode(manager::WriteMode::Append);
+	ASSERT_TRUE(manager::save_string("mem://artifacts/state", "+three"));
+	ASSERT_TRUE(manager::save_string("mem://artifacts/state", "+four"));
+	manager::reset_write_mode();
+	EXPECT_EQ(std::string(std::begin(*shared), std::end(*shared)), "one+two");
+	EXPECT_EQ(manager::load_string("mem://artifacts/state"), "one+two+three+four");
+	EXPECT_EQ(manager::memory().size(), 18);
+	EXPECT_EQ(manager::memory().count(), 1);
+	EXPECT_TRUE(manager::memory().erase("mem://artifacts/state"));
+	EXPECT_TRUE(manager::load_string("mem://artifacts/state").empty());
+
+	std::string saved;
+	ASSERT_TRUE(manager::register_scheme("test://",
+		[](const std::string_view path) {
+			return std::vector<byte>{ std::begin(path), std::end(path) };
+		},
+		[&saved](const std::string_view, const byte *data, const golxzn::core::u32 size, auto) {
+			saved.assign(reinterpret_cast<const char *>(data), size);
+			return true;
+		}
+	));
+	EXPECT_EQ(manager::load_string("test://echo"), "test://echo");
+	EXPECT_TRUE(manager::save_string("test://sink", "payload"));
+	EXPECT_EQ(saved, "payload");
+
+	/// The handlers are called without the lock, so they may change the schemes
+	ASSERT_TRUE(manager::register_scheme("nested://",
+		[](const std::string_view) {
+			EXPECT_TRUE(manager::unregister_scheme("nested://"));
+			return std::vector<byte>{ 1 };
+		},
+		[](const std::string_view, const byte *, const golxzn::core::u32, auto) { return false; }
+	));
+	EXPECT_EQ(manager::load_binary("nested://once"), std::vector<byte>{ 1 });
+	EXPECT_TRUE(manager::load_binary("nested://once").empty());
+
+	EXPECT_FALSE(manager::register_scheme("broken", nullptr, nullptr));
+	EXPECT_TRUE(manager::unregister_scheme("test://"));
+	EXPECT_FALSE(manager::unregister_scheme("test://"));
+	EXPECT_TRUE(manager::load_string("test://echo").empty());
+}
+
+TEST(ResourceManagerTest, OverriddenBuiltinScheme) {
+	using golxzn::core::byte;
+	using golxzn::core::resources::manager;
+	static constexpr std::string_view file{ "res://assets/tests/basic_test.ini" };
+
+	ASSERT_TRUE(manager::register_scheme(manager::ResourcesURL,
+		[](const std::string_view) { return std::vector<byte>{ 'o', 'k' }; },
+		[](const std::string_view, const byte *, const golxzn::core::u32, auto) { return false; }
+	));
+	/// The shared and the mapped loads go through the new handler instead of the files
+	const auto shared{ manager::load_shared(file) };
+	ASSERT_NE(shared, nullptr);
+	EXPECT_EQ(std::string(std::begin(*shared), std::end(*shared)), "ok");
+	const auto view{ manager::map(file) };
+	EXPECT_FALSE(view.is_mapped());
+	EXPECT_EQ(view.as_string(), "ok");
+
+	manager::reset_schemes();
+	EXPECT_NE(manager::load_string(file), "ok");
+	EXPECT_TRUE(manager::map(file).is_mapped());
+}
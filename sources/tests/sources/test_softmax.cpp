@@ -0,0 +1,93 @@
+#include <core/common>
+#include <neural/network.hpp>
+#include <neural/activation/softmax_function.hpp>
+#include <gtest/gtest.h>
+
+TEST(SoftmaxTest, ForwardIsStable) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::activation::SoftmaxFunction;
+
+	const std::vector logits{ 1000.0_f32, 1001.0_f32, 1002.0_f32 };
+	std::vector<golxzn::core::f32> probabilities(logits.size());
+	SoftmaxFunction::forward(logits, probabilities);
+
+	EXPECT_NEAR(probabilities.at(0), 0.09003057, 1e-8);
+	EXPECT_NEAR(probabilities.at(1), 0.24472847, 1e-8);
+	EXPECT_NEAR(probabilities.at(2), 0.66524096, 1e-8);
+	EXPECT_DOUBLE_EQ(std::accumulate(std::begin(probabilities), std::end(probabilities), 0.0_f32), 1.0);
+}
+
+TEST(SoftmaxTest, FusedCrossEntropy) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::activation::SoftmaxFunction;
+
+	const std::vector logits{ 2.0_f32, -1.0_f32, 0.5_f32 };
+	const std::vector target{ 0.0_f32, 0.0_f32, 1.0_f32 };
+	std::vector<golxzn::core::f32> gradient(logits.size());
+	const auto loss{ SoftmaxFunction::cross_entropy(logits, target, gradient) };
+	ASSERT_TRUE(loss.has_value());
+
+	std::vector<golxzn::core::f32> probabilities(logits.size());
+	SoftmaxFunction::forward(logits, probabilities);
+	EXPECT_NEAR(*loss, -std::log(probabilities.at(2)), 1e-12);
+	for (size_t i{}; i < logits.size(); ++i) {
+		EXPECT_NEAR(gradient.at(i), probabilities.at(i) - target.at(i), 1e-12);
+	}
+
+	const std::vector huge{ 1e4_f32, -1e4_f32 };
+	const std::vector second{ 0.0_f32, 1.0_f32 };
+	EXPECT_DOUBLE_EQ(SoftmaxFunction::cross_entropy(huge, second).value_or(0.0_f32), 2e4);
+
+	EXPECT_FALSE(SoftmaxFunction::cross_entropy(logits, second).has_value());
+	std::vector<golxzn::core::f32> short_gradient(2);
+	EXPECT_FALSE(SoftmaxFunction::cross_entropy(logits, target, short_gradient).has_value());
+}
+
+TEST(SoftmaxTest, NetworkOutputStage) {
+	using namespace golxzn::types_literals;
+	using golxzn::neural::Layer;
+	using golxzn::neural::activation::SoftmaxFunction;
+
+	auto network{ std::make_shared<golxzn::neural::Network>() };
+	network->add_layer({ Layer::Type::Input, 2_u32, nullptr });
+	network->add_layer({ Layer::Type::Output, 3_u32, std::make_shared<SoftmaxFunction>() });
+	network->generate_values(false);
+	network->alter_weights({
+		{ { 0.5_f32, -0.25_f32, 1.0_f32 }, { -1.0_f32, 0.75_f32, 0.5_f32 }, { 0.1_f32, 0.2_f32, -0.3_f32 } },
+		{ {}, {}, {} }
+	});
+
+	/// The inputs are 1 and 2, and the bias is 1
+	const std::vector input{ 1.0_f32, 2.0_f32 };
+	const std::vector logits{ -1.4_f32, 1.45_f32, 1.7_f32 };
+	std::vector<golxzn::core::f32> probabilities(logits.size());
+	SoftmaxFunction::forward(logits, probabilities);
+
+	const auto output{ network->predict(input) };
+	ASSERT_EQ(output.size(), probabilities.size());
+	for (size_t i{}; i < output.size(); ++i) {
+		EXPECT_NEAR(output.at(i), probabilities.at(i), 1e-6);
+	}
+
+	const std::vector target{ 0.0_f32, 1.0_f32, 0.0_f32 };
+	EXPECT_NEAR(network->loss(input, target), -std::log(probabilities.at(1)), 1e-6);
+
+	golxzn::neural::Gradient gradient;
+	ASSERT_TRUE(network->back_propagation_shifts(target, gradient));
+	EXPECT_TRUE(gradient.layer(0).empty());
+	for (golxzn::core::u32 j{}; j < 3; ++j) {
+		const auto prop_value{ probabilities.at(j) - target.at(j) };
+		EXPECT_NEAR(gradient.output()[j], prop_value, 1e-6);
+
+		const auto shifts{ gradient.neuron(1, j) };
+		ASSERT_EQ(shifts.size(), 3);
+		EXPECT_NEAR(shifts[0], -prop_value * 1.0, 1e-6);
+		EXPECT_NEAR(shifts[1], -prop_value * 2.0, 1e-6);
+		EXPECT_NEAR(shifts[2], -prop_value * 1.0, 1e-6);
+	}
+
+	/// The wrong target is reported instead of reading out of bounds
+	const std::vector short_target{ 0.0_f32, 1.0_f32 };
+	EXPECT_FALSE(network->back_propagation_shifts(short_target, gradient));
+	EXPECT_EQ(network->loss(input, short_target), 0.0_f32);
+}
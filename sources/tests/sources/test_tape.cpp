@@ -0,0 +1,66 @@
+#include <core/common>
+#include <neural/tape.hpp>
+#include <neural/activation/tape_function.hpp>
+#include <neural/activation/sigmoid_function.hpp>
+#include <gtest/gtest.h>
+
+namespace {
+
+class SoftplusFunction final : public golxzn::neural::activation::TapeFunction {
+public:
+	SoftplusFunction() noexcept : TapeFunction{ "softplus" } {}
+
+	golxzn::neural::Tape::Variable expression(const golxzn::neural::Tape::Variable &x) const override {
+		return golxzn::neural::log(1.0 + golxzn::neural::exp(x));
+	}
+};
+
+} // anonymous namespace
+
+TEST(TapeTest, Gradients) {
+	using namespace golxzn::types_literals;
+	using namespace golxzn::neural;
+
+	Tape tape;
+	const auto x{ tape.variable(2.0_f32) };
+	const auto y{ tape.variable(-3.0_f32) };
+	const auto z{ x * x * y + exp(x) / y - sigmoid(y) };
+	tape.backward(z);
+
+	EXPECT_DOUBLE_EQ(z.value(), 4.0 * -3.0 + std::exp(2.0) / -3.0 - 1.0 / (1.0 + std::exp(3.0)));
+	EXPECT_NEAR(x.adjoint(), 2.0 * 2.0 * -3.0 + std::exp(2.0) / -3.0, 1e-12);
+	const auto s{ 1.0 / (1.0 + std::exp(3.0)) };
+	EXPECT_NEAR(y.adjoint(), 4.0 - std::exp(2.0) / 9.0 - s * (1.0 - s), 1e-12);
+}
+
+TEST(TapeTest, ResetKeepsArena) {
+	using namespace golxzn::types_literals;
+	using namespace golxzn::neural;
+
+	Tape tape;
+	std::vector values(100, 0.5_f32);
+	auto variables{ tape.variables(values) };
+	const auto total{ tape.dot(variables, variables) };
+	tape.backward(total);
+	EXPECT_DOUBLE_EQ(total.value(), 25.0);
+	EXPECT_DOUBLE_EQ(variables.front().adjoint(), 1.0);
+
+	const auto capacity{ tape.capacity() };
+	tape.reset();
+	EXPECT_EQ(tape.size(), 0_u32);
+	EXPECT_EQ(tape.capacity(), capacity);
+
+	const auto w{ tape.variable(3.0_f32) };
+	tape.backward(square(w));
+	EXPECT_DOUBLE_EQ(w.adjoint(), 6.0);
+	EXPECT_EQ(tape.capacity(), capacity);
+}
+
+TEST(TapeTest, CustomFunction) {
+	using namespace golxzn::types_literals;
+
+	const SoftplusFunction softplus;
+	const golxzn::neural::activation::SigmoidFunction sigmoid;
+	EXPECT_NEAR(softplus(0.7_f32), std::log(1.0 + std::exp(0.7)), 1e-12);
+	EXPECT_NEAR(softplus[0.7_f32], sigmoid(0.7_f32), 1e-12);
+}
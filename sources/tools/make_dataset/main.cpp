@@ -0,0 +1,91 @@
+#include <charconv>
+#include <core/common>
+#include <neural/dataset_converter.hpp>
+
+// Usage:
+// make_dataset --source=image_dataset.csv [--output=image_dataset.bin] [--outputs=1] [--threads=0]
+//              [--separator=,] [--skip-header] [--headerless]
+
+namespace {
+
+using namespace golxzn;
+
+std::optional<std::string_view> option(const std::string_view argument, const std::string_view name) {
+	if (!argument.starts_with(name)) return std::nullopt;
+	const auto rest{ argument.substr(name.size()) };
+	if (rest.empty()) return rest;
+	if (rest.front() != '=') return std::nullopt;
+	return rest.substr(1);
+}
+
+std::optional<core::u32> to_u32(const std::string_view value) {
+	core::u32 result{};
+	const auto end{ value.data() + value.size() };
+	if (const auto [ptr, ec]{ std::from_chars(value.data(), end, result) }; ec != std::errc{} || ptr != end) {
+		return std::nullopt;
+	}
+	return result;
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+	core::fs::path source;
+	core::fs::path output;
+	std::optional<char> separator;
+	neural::DatasetConverter::Settings settings;
+
+	for (int i{ 1 }; i < argc; ++i) {
+		const std::string_view argument{ argv[i] };
+		if (const auto value{ option(argument, "--source") }) {
+			source = core::fs::path{ *value };
+		} else if (const auto value{ option(argument, "--output") }) {
+			output = core::fs::path{ *value };
+		} else if (const auto value{ option(argument, "--outputs") }) {
+			const auto count{ to_u32(*value) };
+			if (!count.has_value()) {
+				spdlog::error("Invalid --outputs value '{}'", *value);
+				return 1;
+			}
+			settings.output_count = *count;
+		} else if (const auto value{ option(argument, "--threads") }) {
+			const auto count{ to_u32(*value) };
+			if (!count.has_value()) {
+				spdlog::error("Invalid --threads value '{}'", *value);
+				return 1;
+			}
+			settings.threads_count = *count;
+		} else if (const auto value{ option(argument, "--separator") }; value && value->size() == 1) {
+			separator = value->front();
+		} else if (argument == "--skip-header") {
+			settings.skip_first_line = true;
+		} else if (argument == "--headerless") {
+			settings.write_counts = false;
+		} else {
+			spdlog::error("Unknown argument '{}'", argument);
+			return 1;
+		}
+	}
+
+	if (source.empty()) {
+		spdlog::error("Set the --source option!");
+		return 1;
+	}
+	if (output.empty()) {
+		output = core::fs::path{ source }.replace_extension(".bin");
+	}
+	settings.separator = separator.value_or(neural::DatasetConverter::separator_of(source));
+
+	spdlog::info("Source: {}", source.string());
+	spdlog::info("Output: {}", output.string());
+
+	const auto start{ std::chrono::steady_clock::now() };
+	if (!neural::DatasetConverter::convert(source, output, settings)) {
+		return 1;
+	}
+	const std::chrono::duration<core::f32> elapsed{ std::chrono::steady_clock::now() - start };
+	const auto megabytes{ static_cast<core::f32>(core::fs::file_size(source)) / (1024.0 * 1024.0) };
+	spdlog::info("Converted {:.1f} MiB in {:.3f} s ({:.1f} MiB/s)", megabytes, elapsed.count(),
+		megabytes / (std::max)(elapsed.count(), 1e-9));
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <charconv>
+#include <core/common>
+#include <core/resources/asset_pack.hpp>
+
+// Usage:
+// pack_assets --source=assets [--output=assets.pack] [--store] [--level=6]
+
+namespace {
+
+using namespace golxzn;
+
+std::optional<std::string_view> option(const std::string_view argument, const std::string_view name) {
+	if (!argument.starts_with(name)) return std::nullopt;
+	const auto rest{ argument.substr(name.size()) };
+	if (rest.empty()) return rest;
+	if (rest.front() != '=') return std::nullopt;
+	return rest.substr(1);
+}
+
+} // anonymous namespace
+
+int main(int argc, char **argv) {
+	core::fs::path source;
+	core::fs::path output;
+	core::resources::asset_pack::settings settings;
+
+	for (int i{ 1 }; i < argc; ++i) {
+		const std::string_view argument{ argv[i] };
+		if (const auto value{ option(argument, "--source") }) {
+			source = core::fs::path{ *value };
+		} else if (const auto value{ option(argument, "--output") }) {
+			output = core::fs::path{ *value };
+		} else if (const auto value{ option(argument, "--level") }) {
+			const auto end{ value->data() + value->size() };
+			const auto [ptr, ec]{ std::from_chars(value->data(), end, settings.level) };
+			if (ec != std::errc{} || ptr != end || settings.level < 0 || settings.level > 9) {
+				spdlog::error("Invalid --level value '{}'. Use 0-9", *value);
+				return 1;
+			}
+		} else if (argument == "--store") {
+			settings.compress = false;
+		} else {
+			spdlog::error("Unknown argument '{}'", argument);
+			return 1;
+		}
+	}
+
+	if (source.empty()) {
+		spdlog::error("Set the --source option!");
+		return 1;
+	}
+	if (output.empty()) {
+		output = source.lexically_normal();
+		if (!output.has_filename()) output = output.parent_path();
+		output += core::resources::asset_pack::extension;
+	}
+
+	spdlog::info("Source: {}", source.string());
+	spdlog::info("Output: {}", output.string());
+
+	const auto start{ std::chrono::steady_clock::now() };
+	if (!core::resources::asset_pack::build(source, output, settings)) {
+		return 1;
+	}
+	const std::chrono::duration<core::f32> elapsed{ std::chrono::steady_clock::now() - start };
+	const core::resources::asset_pack pack{ output };
+	spdlog::info("Packed {} assets into {:.1f} KiB in {:.3f} s", pack.entries_count(),
+		static_cast<core::f32>(core::fs::file_size(output)) / 1024.0, elapsed.count());
+	return 0;
+}